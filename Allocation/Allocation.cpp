@@ -0,0 +1,197 @@
+/**
+ * @file Allocation.cpp
+ * @brief This file contains the implementation of the allocation counting of the application
+ * and the global operator new and delete that feed it.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "Allocation.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+
+namespace allocation {
+    ERRORS_
+    BR_EXCEPT_
+
+    namespace {
+        /**
+         * @brief Totals of all threads, counted with relaxed atomics.
+         */
+        atomic<uint64_t> allocationTotal = 0;
+        atomic<uint64_t> byteTotal = 0;
+        atomic<uint64_t> hotPathTotal = 0;
+
+        /**
+         * @brief The biggest number of stages in the report, later stages are dropped.
+         */
+        constexpr size_t MAX_STAGES = 32;
+
+        /**
+         * @brief One finished stage.
+         */
+        struct StageCounts {
+            const char *name; ///< Name of the stage.
+            AllocationCounts counts; ///< Allocations made during the stage.
+        };
+
+        /**
+         * @brief Finished stages, a fixed array, so recording a stage doesn't allocate itself.
+         */
+        mutex stageMutex;
+        array<StageCounts, MAX_STAGES> stages;
+        size_t stageCount = 0;
+    }
+
+    /**
+     * @brief Starts counting, the allocations made before aren't counted.
+     */
+    void startCounting() {
+        countingEnabled.store(true, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the allocations of all threads since counting started.
+     */
+    AllocationCounts allocationCounts() {
+        return {allocationTotal.load(memory_order_relaxed), byteTotal.load(memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Returns the number of allocations made inside hot path scopes.
+     */
+    uint64_t hotPathAllocations() {
+        return hotPathTotal.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts one allocation, it is called by the global operator new.
+     *
+     * @param bytes The number of requested bytes.
+     */
+    void countAllocation(const size_t bytes) {
+        if (!countingEnabled.load(memory_order_relaxed))
+            return;
+
+        allocationTotal.fetch_add(1, memory_order_relaxed);
+        byteTotal.fetch_add(bytes, memory_order_relaxed);
+        if (hotPathDepth != 0)
+            hotPathTotal.fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Checks that no hot path scope has allocated.
+     *
+     * If one has, it throws a BracedException with a specific error message.
+     */
+    void checkHotPath() {
+        if (const uint64_t allocations = hotPathAllocations(); allocations != 0)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[HOT_PATH_ALLOCATED], allocations);
+    }
+
+    /**
+     * @brief Writes the allocations of every finished stage, the totals and the hot path allocations.
+     *
+     * @param out The stream for the report.
+     */
+    void writeAllocationReport(ostream &out) {
+        lock_guard lock(stageMutex);
+        out << "Allocations:\n";
+        for (size_t i = 0; i < stageCount; ++i)
+            out << "* " << stages[i].name << ": " << stages[i].counts.allocations << " allocations, "
+                    << stages[i].counts.bytes << " bytes\n";
+
+        const AllocationCounts total = allocationCounts();
+        out << "* total: " << total.allocations << " allocations, " << total.bytes << " bytes\n"
+                << "* hot path: " << hotPathAllocations() << " allocations" << endl;
+    }
+
+    /**
+     * @brief Ends the stage and records its allocations.
+     */
+    void AllocationStage::end() {
+        if (!active_)
+            return;
+        active_ = false;
+
+        const AllocationCounts now = allocationCounts();
+        lock_guard lock(stageMutex);
+        if (stageCount < MAX_STAGES)
+            stages[stageCount++] = {name_, {now.allocations - begin_.allocations, now.bytes - begin_.bytes}};
+    }
+
+    /**
+     * @brief Starts counting if the report is enabled.
+     *
+     * @param enabled Count allocations and print the report.
+     */
+    AllocationReport::AllocationReport(const bool enabled)
+        : enabled_(enabled) {
+        if (enabled_)
+            startCounting();
+    }
+
+    /**
+     * @brief Prints the report to the standard output.
+     */
+    AllocationReport::~AllocationReport() {
+        if (enabled_)
+            writeAllocationReport(cout);
+    }
+}
+
+/**
+ * @brief Global allocation functions, they count every allocation of the program while counting is enabled.
+ *
+ * All other forms of operator new and delete of the standard library call these ones.
+ */
+void *operator new(const std::size_t size) {
+    allocation::countAllocation(size);
+    if (void *pointer = std::malloc(size != 0 ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment) {
+    allocation::countAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    if (void *pointer = _aligned_malloc(size != 0 ? size : 1, align))
+        return pointer;
+#else
+    if (void *pointer = std::aligned_alloc(align, ((size != 0 ? size : 1) + align - 1) / align * align))
+        return pointer;
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+// Aligned memory of MSVC must be freed by its own function
+void operator delete(void *pointer, std::align_val_t) noexcept {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void operator delete(void *pointer, std::size_t, const std::align_val_t alignment) noexcept {
+    operator delete(pointer, alignment);
+}
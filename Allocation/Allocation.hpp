@@ -0,0 +1,137 @@
+/**
+ * @file Allocation.hpp
+ * @brief This file contains the declaration of the allocation counting of the application.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef ALLOCATION_HPP
+#define ALLOCATION_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Namespace for allocation counting.
+ */
+namespace allocation {
+    using namespace std;
+
+    /**
+     * @brief Allocations are counted, checked by the global operator new before it counts.
+     */
+    inline atomic<bool> countingEnabled{false};
+
+    /**
+     * @brief Depth of hot path scopes of the current thread, allocations inside them are violations.
+     */
+    inline thread_local uint32_t hotPathDepth = 0;
+
+    /**
+     * @brief Number of allocations and their bytes.
+     */
+    struct AllocationCounts {
+        uint64_t allocations = 0; ///< Number of allocations.
+        uint64_t bytes = 0; ///< Number of requested bytes.
+    };
+
+    void startCounting();
+
+    AllocationCounts allocationCounts();
+
+    uint64_t hotPathAllocations();
+
+    void countAllocation(size_t bytes);
+
+    void checkHotPath();
+
+    void writeAllocationReport(ostream &out);
+
+    /**
+     * @brief Marks a block that must not allocate, f.e. the inner loop of the search.
+     *
+     * Without counting it only checks a flag, so it may stay in the hot loops.
+     */
+    class HotPathScope {
+    public:
+        HotPathScope()
+            : active_(countingEnabled.load(memory_order_relaxed)) {
+            if (active_)
+                ++hotPathDepth;
+        }
+
+        ~HotPathScope() {
+            if (active_)
+                --hotPathDepth;
+        }
+
+        HotPathScope(const HotPathScope &) = delete;
+
+        HotPathScope &operator=(const HotPathScope &) = delete;
+
+    private:
+        bool active_;
+    };
+
+    /**
+     * @brief Records the allocations of all threads between its construction and end() as one stage of the report.
+     */
+    class AllocationStage {
+    public:
+        /**
+         * @brief Begins a stage.
+         *
+         * @param name The name of the stage, it must be a string literal.
+         */
+        explicit AllocationStage(const char *name)
+            : name_(name),
+              active_(countingEnabled.load(memory_order_relaxed)),
+              begin_(active_ ? allocationCounts() : AllocationCounts{}) {
+        }
+
+        /**
+         * @brief Ends the stage, if it wasn't ended before.
+         */
+        ~AllocationStage() {
+            end();
+        }
+
+        void end();
+
+        AllocationStage(const AllocationStage &) = delete;
+
+        AllocationStage &operator=(const AllocationStage &) = delete;
+
+    private:
+        const char *name_;
+        bool active_;
+        AllocationCounts begin_;
+    };
+
+    /**
+     * @brief Starts counting when it is constructed and prints the report when it is destroyed,
+     * so the report is printed however the counted block ends.
+     */
+    class AllocationReport {
+    public:
+        explicit AllocationReport(bool enabled);
+
+        ~AllocationReport();
+
+        AllocationReport(const AllocationReport &) = delete;
+
+        AllocationReport &operator=(const AllocationReport &) = delete;
+
+    private:
+        bool enabled_;
+    };
+}
+
+/**
+ * @brief Macro to simplify the use of the allocation namespace.
+ */
+#define ALLOCATION_ using namespace allocation;
+
+#endif // ALLOCATION_HPP
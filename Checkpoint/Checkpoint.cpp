@@ -0,0 +1,137 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief This file contains the implementation of reading and writing search checkpoints.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "Checkpoint.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+
+namespace graph {
+    ERRORS_
+    BR_EXCEPT_
+
+    namespace {
+        /**
+         * @brief Signature and version of the checkpoint format.
+         */
+        constexpr char MAGIC[8] = {'B', 'A', 'D', 'C', 'K', 'P', 'T', '1'};
+
+        void writeValue(ofstream &out, const auto &value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        template<typename T>
+        bool readValue(ifstream &in, T &value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+        }
+    }
+
+    /**
+     * @brief Writes a checkpoint to a file.
+     *
+     * Only components with progress are written, each one with its index.
+     * The checkpoint is written to a temporary file which then replaces the old one,
+     * so an interrupted write never damages the previous checkpoint.
+     * If the file can't be written, it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the file.
+     * @param checkpoint The checkpoint.
+     */
+    void writeCheckpoint(const string &fileName, const Checkpoint &checkpoint) {
+        const string temporaryName = fileName + ".tmp";
+        {
+            ofstream out(temporaryName, ios::binary | ios::trunc);
+            if (!out.is_open())
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], temporaryName);
+
+            uint32_t started = 0;
+            for (const auto &component: checkpoint.components)
+                started += component.nextStart != 0;
+
+            out.write(MAGIC, sizeof(MAGIC));
+            writeValue(out, checkpoint.fingerprint);
+            writeValue(out, static_cast<uint32_t>(checkpoint.components.size()));
+            writeValue(out, started);
+
+            for (uint32_t i = 0; i < checkpoint.components.size(); ++i) {
+                const ComponentProgress &component = checkpoint.components[i];
+                if (component.nextStart == 0)
+                    continue;
+
+                writeValue(out, i);
+                writeValue(out, component.nextStart);
+                writeValue(out, component.length);
+                writeValue(out, component.position);
+                writeValue(out, static_cast<uint32_t>(component.path.size()));
+                out.write(reinterpret_cast<const char *>(component.path.data()),
+                          static_cast<streamsize>(component.path.size() * sizeof(uint32_t)));
+            }
+
+            if (!out.flush())
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], temporaryName);
+        }
+
+        // std::rename fails on Windows if the file exists, this one replaces it everywhere
+        error_code error;
+        filesystem::rename(temporaryName, fileName, error);
+        if (error)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+    }
+
+    /**
+     * @brief Reads a checkpoint from a file.
+     *
+     * If the file can't be opened, isn't a complete checkpoint or was made for a graph with another number
+     * of components, it throws a BracedException with a specific error message.
+     * Sizes are checked before anything is allocated, so a damaged file can't request huge vectors.
+     *
+     * @param fileName The name of the file.
+     * @param componentCount The number of components of the graph.
+     * @param pieceCount The number of pieces of the graph, no path can be longer.
+     * @return The checkpoint.
+     */
+    Checkpoint readCheckpoint(const string &fileName, const size_t componentCount, const size_t pieceCount) {
+        ifstream in(fileName, ios::binary);
+        if (!in.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        Checkpoint checkpoint;
+        char magic[sizeof(MAGIC)];
+        uint32_t savedComponentCount;
+        uint32_t started;
+
+        if (!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            !readValue(in, checkpoint.fingerprint) || !readValue(in, savedComponentCount) ||
+            !readValue(in, started) || started > savedComponentCount)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], fileName);
+        if (savedComponentCount != componentCount)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_MISMATCH], fileName);
+
+        checkpoint.components.resize(componentCount);
+        for (uint32_t i = 0; i < started; ++i) {
+            uint32_t index;
+            uint32_t pathSize;
+            if (!readValue(in, index) || index >= componentCount)
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], fileName);
+
+            ComponentProgress &component = checkpoint.components[index];
+            if (!readValue(in, component.nextStart) || !readValue(in, component.length) ||
+                !readValue(in, component.position) || !readValue(in, pathSize) || pathSize > pieceCount)
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], fileName);
+
+            component.path.resize(pathSize);
+            if (!in.read(reinterpret_cast<char *>(component.path.data()),
+                         static_cast<streamsize>(pathSize * sizeof(uint32_t))))
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], fileName);
+        }
+        return checkpoint;
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file Checkpoint.hpp
+ * @brief This file contains the declaration of search checkpoints.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace graph {
+    using namespace std;
+
+    /**
+     * @brief Settings of checkpoints of a search, an empty file name disables them.
+     */
+    struct CheckpointSettings {
+        string file; ///< File with the checkpoint.
+        bool resume = false; ///< Continue from the checkpoint in the file instead of starting anew.
+        chrono::seconds interval{60}; ///< Time between two checkpoints.
+    };
+
+    /**
+     * @brief Progress of the search in one component.
+     *
+     * A component is done when nextStart is the number of its start vertices,
+     * components that aren't done are the pending work.
+     */
+    struct ComponentProgress {
+        uint32_t nextStart = 0; ///< Index of the first start vertex of the component that isn't searched yet.
+        uint32_t length = 0; ///< Length of the longest combination found in the component.
+        uint32_t position = UINT32_MAX; ///< Position of its start vertex in the start order.
+        vector<uint32_t> path; ///< Its vertices.
+    };
+
+    /**
+     * @brief Snapshot of a search, it is enough to continue the search and get the same result.
+     */
+    struct Checkpoint {
+        uint64_t fingerprint = 0; ///< Fingerprint of the graph, a checkpoint of another graph can't be used.
+        vector<ComponentProgress> components; ///< Progress of every component.
+    };
+
+    void writeCheckpoint(const string &fileName, const Checkpoint &checkpoint);
+
+    Checkpoint readCheckpoint(const string &fileName, size_t componentCount, size_t pieceCount);
+}
+
+#endif // CHECKPOINT_HPP
@@ -24,6 +24,16 @@ namespace errors {
         "String is empty",
         "String has wrong size ({} instead of {})",
         "Couldn't open file ({})",
+        "Couldn't read files ({})",
         "Puzzle combination is invalid ({} at position {}-{})",
+        "Unknown command-line argument ({})",
+        "Option has no value ({})",
+        "Option has unsupported value ({} {})",
+        "Query is invalid ({})",
+        "Checkpoint is damaged ({})",
+        "Checkpoint was made for another graph ({})",
+        "Summary is damaged ({})",
+        "Binary piece file is damaged or has unsupported geometry ({})",
+        "Inner loop of the search allocated memory ({} allocations)",
     };
 }
\ No newline at end of file
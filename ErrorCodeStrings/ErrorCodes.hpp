@@ -43,8 +43,24 @@ namespace errors {
         STRING_WRONG_SIZE, ///< Indicates that the string has an incorrect size.
         // readFile Errors
         FILE_NOT_OPENED, ///< Indicates that the file could not be opened.
+        READ_FAILED, ///< Indicates that files could not be read.
         // puzzleCombinationIsValid Errors
         PUZZLE_INVALID, ///< Indicates that the puzzle combination is invalid.
+        // parseOptions Errors
+        UNKNOWN_OPTION, ///< Indicates that a command-line argument is unknown.
+        OPTION_WITHOUT_VALUE, ///< Indicates that a command-line option has no value.
+        BAD_OPTION_VALUE, ///< Indicates that a command-line option has an unsupported value.
+        // parseQuery Errors
+        BAD_QUERY, ///< Indicates that a query is invalid.
+        // readCheckpoint Errors
+        CHECKPOINT_INVALID, ///< Indicates that a checkpoint file is damaged.
+        CHECKPOINT_MISMATCH, ///< Indicates that a checkpoint was made for another graph.
+        // mergeSummary Errors
+        SUMMARY_INVALID, ///< Indicates that a summary file is damaged.
+        // readBinaryPieces Errors
+        BINARY_INVALID, ///< Indicates that a binary piece file is damaged or has another geometry.
+        // checkHotPath Errors
+        HOT_PATH_ALLOCATED, ///< Indicates that the inner loop of the search allocated memory.
     };
 }
 
@@ -0,0 +1,107 @@
+/**
+ * @file BufferedWriter.cpp
+ * @brief This file contains the implementation of the BufferedWriter class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "BufferedWriter.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace graph {
+    /**
+     * @brief Creates a writer for a stream.
+     *
+     * @param out The stream that receives the text.
+     * @param bufferSize The size of the buffer.
+     */
+    BufferedWriter::BufferedWriter(ostream &out, const size_t bufferSize)
+        : out_(out),
+          buffer_(bufferSize < 64 ? 64 : bufferSize) {
+    }
+
+    /**
+     * @brief Sends the rest of the text to the stream.
+     */
+    BufferedWriter::~BufferedWriter() {
+        flush();
+    }
+
+    /**
+     * @brief Writes a text.
+     *
+     * @param text The text.
+     * @return The writer.
+     */
+    BufferedWriter &BufferedWriter::operator<<(const string_view text) {
+        // Long texts go directly to the stream
+        if (text.size() > buffer_.size()) {
+            flush();
+            out_.write(text.data(), static_cast<streamsize>(text.size()));
+            return *this;
+        }
+        reserve(text.size());
+        memcpy(buffer_.data() + size_, text.data(), text.size());
+        size_ += text.size();
+        return *this;
+    }
+
+    /**
+     * @brief Writes a symbol.
+     *
+     * @param symbol The symbol.
+     * @return The writer.
+     */
+    BufferedWriter &BufferedWriter::operator<<(const char symbol) {
+        reserve(1);
+        buffer_[size_++] = symbol;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a number in decimal form.
+     *
+     * @param number The number.
+     * @return The writer.
+     */
+    BufferedWriter &BufferedWriter::operator<<(const uint64_t number) {
+        reserve(20);
+        size_ = static_cast<size_t>(to_chars(buffer_.data() + size_, buffer_.data() + buffer_.size(), number).ptr -
+                                    buffer_.data());
+        return *this;
+    }
+
+    /**
+     * @brief Writes a number from 0 to 99 with a leading zero, the way pieces are written.
+     *
+     * @param number The number.
+     * @return The writer.
+     */
+    BufferedWriter &BufferedWriter::twoDigits(const unsigned number) {
+        reserve(2);
+        buffer_[size_++] = static_cast<char>('0' + number / 10 % 10);
+        buffer_[size_++] = static_cast<char>('0' + number % 10);
+        return *this;
+    }
+
+    /**
+     * @brief Sends the collected text to the stream.
+     */
+    void BufferedWriter::flush() {
+        if (size_ > 0)
+            out_.write(buffer_.data(), static_cast<streamsize>(size_));
+        size_ = 0;
+    }
+
+    /**
+     * @brief Makes room for a number of symbols, flushing the buffer if needed.
+     *
+     * @param count The number of symbols.
+     */
+    void BufferedWriter::reserve(const size_t count) {
+        if (size_ + count > buffer_.size())
+            flush();
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file BufferedWriter.hpp
+ * @brief This file contains the declaration of the BufferedWriter class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace graph {
+    using namespace std;
+
+    /**
+     * @brief Writer that collects small pieces of text in a fixed buffer and sends them to a stream in big blocks.
+     *
+     * Numbers are formatted in place, so writing doesn't allocate after construction.
+     */
+    class BufferedWriter {
+    public:
+        /**
+         * @brief Default size of the buffer.
+         */
+        static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+        explicit BufferedWriter(ostream &out, size_t bufferSize = BUFFER_SIZE);
+
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter &) = delete;
+
+        BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+        BufferedWriter &operator<<(string_view text);
+
+        BufferedWriter &operator<<(char symbol);
+
+        BufferedWriter &operator<<(uint64_t number);
+
+        BufferedWriter &twoDigits(unsigned number);
+
+        void flush();
+
+    private:
+        ostream &out_;
+        vector<char> buffer_;
+        size_t size_ = 0;
+
+        void reserve(size_t count);
+    };
+}
+
+#endif // BUFFERED_WRITER_HPP
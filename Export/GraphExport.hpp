@@ -0,0 +1,36 @@
+/**
+ * @file GraphExport.hpp
+ * @brief This file contains the declaration of functions for exporting a graph.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef GRAPH_EXPORT_HPP
+#define GRAPH_EXPORT_HPP
+
+#include <ostream>
+#include <sstream>
+#include <unordered_set>
+#include "../Graph/Graph.hpp"
+#include "BufferedWriter.hpp"
+
+namespace graph {
+    /**
+     * @brief Formats of the graph export.
+     */
+    enum class ExportFormat {
+        TEXT, ///< The adjacency dump printed by the `s` flag.
+        DOT, ///< Graphviz DOT.
+        JSON, ///< JSON with nodes, edges and the path.
+    };
+
+    template<typename vType, size_t vCount>
+    void exportGraph(const Graph<vType, vCount> &graph, ostream &out, ExportFormat format,
+                     const vector<uint32_t> &path = {});
+
+    template<typename T, size_t C>
+    string to_string(const Graph<T, C> &graph);
+}
+
+#endif // GRAPH_EXPORT_HPP
+#include "GraphExport.inl"
@@ -0,0 +1,137 @@
+/**
+ * @file GraphExport.inl
+ * @brief This file contains the implementation of functions for exporting a graph.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef GRAPH_EXPORT_INL
+#define GRAPH_EXPORT_INL
+
+namespace graph {
+    /**
+     * @brief Writes the numbers of a vertex as a puzzle piece, f.e. 561234.
+     *
+     * @param writer The writer.
+     * @param vertex The vertex.
+     */
+    template<typename vType, size_t vCount>
+    void writePiece(BufferedWriter &writer, const Vertex<vType, vCount> &vertex) {
+        for (const vType &number: *vertex.vNumbers())
+            writer.twoDigits(static_cast<unsigned>(number));
+    }
+
+    /**
+     * @brief Collects the edges of a path, so they can be found in O(1).
+     *
+     * @param path Positions of the vertices in the path.
+     * @return The set of edges, each edge is the source position in the high half and the target in the low one.
+     */
+    inline unordered_set<uint64_t> pathEdges(const vector<uint32_t> &path) {
+        unordered_set<uint64_t> edges;
+        edges.reserve(path.size());
+        for (size_t i = 1; i < path.size(); ++i)
+            edges.insert(static_cast<uint64_t>(path[i - 1]) << 32 | path[i]);
+        return edges;
+    }
+
+    /**
+     * @brief Streams a graph in one of the export formats.
+     *
+     * Vertices and edges are written one by one through a buffered writer, without building the whole text,
+     * so the time is linear in the size of the graph and the memory doesn't depend on it.
+     * Vertices and edges of the path are highlighted in DOT and marked in JSON.
+     * Identical pieces may be different vertices, so vertices are named by their positions in the graph.
+     *
+     * @param graph The graph.
+     * @param out The stream that receives the export.
+     * @param format The format.
+     * @param path Positions of the vertices of the path to highlight, f.e. Graph::bestPath().
+     */
+    template<typename vType, size_t vCount>
+    void exportGraph(const Graph<vType, vCount> &graph, ostream &out, const ExportFormat format,
+                     const vector<uint32_t> &path) {
+        BufferedWriter writer(out);
+        const size_t vertexCount = graph.vertexCount();
+
+        vector<bool> onPath(vertexCount, false);
+        for (const uint32_t vertex: path)
+            onPath[vertex] = true;
+        const unordered_set<uint64_t> edgesOnPath = pathEdges(path);
+        auto edgeOnPath = [&](const uint32_t from, const uint32_t to) {
+            return edgesOnPath.contains(static_cast<uint64_t>(from) << 32 | to);
+        };
+
+        switch (format) {
+            case ExportFormat::TEXT:
+                for (uint32_t v = 0; v < vertexCount; ++v) {
+                    writer << '[';
+                    writePiece(writer, *graph.vertexAt(v));
+                    writer << "]:\n";
+                    for (const uint32_t e: graph.neighbors(v)) {
+                        writer << "  ->";
+                        writePiece(writer, *graph.vertexAt(e));
+                        writer << '\n';
+                    }
+                }
+                break;
+
+            case ExportFormat::DOT:
+                writer << "digraph puzzle {\n  node [shape=box];\n";
+                for (uint32_t v = 0; v < vertexCount; ++v) {
+                    writer << "  v" << static_cast<uint64_t>(v) << " [label=\"";
+                    writePiece(writer, *graph.vertexAt(v));
+                    if (graph.vertexAt(v)->count() > 1)
+                        writer << " x" << static_cast<uint64_t>(graph.vertexAt(v)->count());
+                    writer << (onPath[v] ? "\", color=red, style=bold];\n" : "\"];\n");
+                }
+                for (uint32_t v = 0; v < vertexCount; ++v)
+                    for (const uint32_t e: graph.neighbors(v)) {
+                        writer << "  v" << static_cast<uint64_t>(v) << " -> v" << static_cast<uint64_t>(e);
+                        writer << (edgeOnPath(v, e) ? " [color=red, penwidth=2];\n" : ";\n");
+                    }
+                writer << "}\n";
+                break;
+
+            case ExportFormat::JSON:
+                writer << "{\"nodes\":[";
+                for (uint32_t v = 0; v < vertexCount; ++v) {
+                    writer << (v ? ",\n" : "\n") << "{\"id\":" << static_cast<uint64_t>(v) << ",\"piece\":\"";
+                    writePiece(writer, *graph.vertexAt(v));
+                    writer << "\",\"count\":" << static_cast<uint64_t>(graph.vertexAt(v)->count())
+                            << ",\"onPath\":" << (onPath[v] ? "true}" : "false}");
+                }
+                writer << "],\n\"edges\":[";
+                bool first = true;
+                for (uint32_t v = 0; v < vertexCount; ++v)
+                    for (const uint32_t e: graph.neighbors(v)) {
+                        writer << (first ? "\n[" : ",\n[") << static_cast<uint64_t>(v) << ','
+                                << static_cast<uint64_t>(e) << (edgeOnPath(v, e) ? ",true]" : ",false]");
+                        first = false;
+                    }
+                writer << "],\n\"path\":[";
+                for (size_t i = 0; i < path.size(); ++i)
+                    writer << (i ? "," : "") << static_cast<uint64_t>(path[i]);
+                writer << "]}\n";
+                break;
+        }
+    }
+
+    /**
+     * @brief Converts a graph to a string representation.
+     *
+     * This function converts a graph to a string representation,
+     * displaying the vertices and their edges in a readable format.
+     * Big graphs should be streamed with exportGraph instead.
+     *
+     * @param graph The graph to be converted to a string.
+     * @return The string representation of the graph.
+     */
+    template<typename T, size_t C>
+    string to_string(const Graph<T, C> &graph) {
+        ostringstream out;
+        exportGraph(graph, out, ExportFormat::TEXT);
+        return std::move(out).str();
+    }
+}
+#endif // GRAPH_EXPORT_INL
@@ -0,0 +1,112 @@
+/**
+ * @file BinaryPieces.cpp
+ * @brief This file contains the implementation of the binary piece format.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "BinaryPieces.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace reader {
+    /**
+     * @brief Function to check if the content of a file is in the binary piece format.
+     *
+     * @param prefix The first bytes of the file.
+     * @return True if the file starts with the binary signature.
+     */
+    bool isBinaryPieces(const string_view prefix) {
+        return prefix.size() >= sizeof(BINARY_MAGIC) && memcmp(prefix.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+    }
+
+    /**
+     * @brief Function to parse the header of a binary piece file.
+     *
+     * Only pieces of two-digit numbers are supported, with the key of a piece in 20 bits.
+     * If the header is damaged or has another geometry, it throws a BracedException with a specific error message.
+     *
+     * @param header The first BINARY_HEADER_SIZE bytes of the file.
+     * @param numberCount The expected number of numbers in a piece.
+     * @param fileName The name of the file, for error messages.
+     * @return The header.
+     */
+    BinaryHeader parseBinaryHeader(const string_view header, const size_t numberCount, const string &fileName) {
+        if (header.size() < BINARY_HEADER_SIZE || !isBinaryPieces(header) ||
+            static_cast<uint8_t>(header[4]) != BINARY_VERSION)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+
+        BinaryHeader result;
+        result.numberCount = static_cast<uint8_t>(header[5]);
+        result.numberDigits = static_cast<uint8_t>(header[6]);
+        result.hasCounts = (static_cast<uint8_t>(header[7]) & 1) != 0;
+        for (size_t i = 0; i < sizeof(result.recordCount); ++i)
+            result.recordCount |= static_cast<uint64_t>(static_cast<uint8_t>(header[8 + i])) << (i * 8);
+
+        if (result.numberCount != numberCount || result.numberCount != 3 || result.numberDigits != 2)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+        return result;
+    }
+
+    /**
+     * @brief Function to write pieces of three two-digit numbers to a binary piece file.
+     *
+     * Without multiplicities every piece is a 3-byte key, with them every record is 4 bytes:
+     * the key in the low 20 bits and the multiplicity in the high 12 bits. A multiplicity bigger than
+     * BINARY_MAX_COUNT takes several records.
+     * If the file can't be written, it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the file.
+     * @param pieces Keys of the pieces with their multiplicities.
+     * @param withCounts Write multiplicities, otherwise every piece is written as many times as it has copies.
+     */
+    void writeBinaryPieces(const string &fileName, const vector<pair<uint32_t, uint32_t> > &pieces,
+                           const bool withCounts) {
+        ofstream out(fileName, ios::binary | ios::trunc);
+        if (!out.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        uint64_t recordCount = 0;
+        for (const auto &[key, count]: pieces)
+            recordCount += withCounts ? (count + BINARY_MAX_COUNT - 1) / BINARY_MAX_COUNT : count;
+
+        char header[BINARY_HEADER_SIZE] = {};
+        memcpy(header, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        header[4] = static_cast<char>(BINARY_VERSION);
+        header[5] = 3;
+        header[6] = 2;
+        header[7] = withCounts ? 1 : 0;
+        for (size_t i = 0; i < sizeof(recordCount); ++i)
+            header[8 + i] = static_cast<char>(recordCount >> (i * 8));
+        out.write(header, BINARY_HEADER_SIZE);
+
+        // Records are collected in a buffer and written in big blocks
+        string buffer;
+        buffer.reserve(1 << 20);
+        auto writeRecord = [&](const uint32_t value, const size_t size) {
+            for (size_t i = 0; i < size; ++i)
+                buffer += static_cast<char>(value >> (i * 8));
+            if (buffer.size() >= (1 << 20) - 4) {
+                out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        };
+
+        for (const auto &[key, count]: pieces)
+            if (withCounts)
+                for (uint32_t left = count; left != 0;) {
+                    const uint32_t part = std::min(left, BINARY_MAX_COUNT);
+                    writeRecord(key | part << BINARY_KEY_BITS, 4);
+                    left -= part;
+                }
+            else
+                for (uint32_t copy = 0; copy < count; ++copy)
+                    writeRecord(key, 3);
+
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        if (!out.flush())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+    }
+}
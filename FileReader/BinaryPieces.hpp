@@ -0,0 +1,87 @@
+/**
+ * @file BinaryPieces.hpp
+ * @brief This file contains the declaration of the packed binary format of piece files.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef BINARY_PIECES_HPP
+#define BINARY_PIECES_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+
+namespace reader {
+    using namespace std;
+
+    ERRORS_
+    BR_EXCEPT_
+
+    /**
+     * @brief Signature at the beginning of every binary piece file.
+     */
+    constexpr char BINARY_MAGIC[4] = {'B', 'A', 'D', 'P'};
+
+    /**
+     * @brief Version of the binary format.
+     */
+    constexpr uint8_t BINARY_VERSION = 1;
+
+    /**
+     * @brief Size of the header of a binary piece file.
+     */
+    constexpr size_t BINARY_HEADER_SIZE = 16;
+
+    /**
+     * @brief Number of bits of the key in a record with a multiplicity, the rest of 32 bits is the multiplicity.
+     */
+    constexpr unsigned BINARY_KEY_BITS = 20;
+
+    /**
+     * @brief The biggest multiplicity of one record, more copies take more records.
+     */
+    constexpr uint32_t BINARY_MAX_COUNT = (1u << (32 - BINARY_KEY_BITS)) - 1;
+
+    /**
+     * @brief Header of a binary piece file.
+     *
+     * Layout (little-endian): magic (4 bytes), version (1), numbers in a piece (1), digits in a number (1),
+     * flags (1, bit 0 means records with multiplicities), number of records (8).
+     */
+    struct BinaryHeader {
+        uint8_t numberCount = 3; ///< Numbers in a piece.
+        uint8_t numberDigits = 2; ///< Digits in a number.
+        bool hasCounts = false; ///< Records have multiplicities.
+        uint64_t recordCount = 0; ///< Number of records after the header.
+
+        /**
+         * @brief Size of one record: 3 bytes of a key, or 4 bytes of a key and a multiplicity.
+         */
+        size_t recordSize() const { return hasCounts ? 4 : 3; }
+    };
+
+    bool isBinaryPieces(string_view prefix);
+
+    BinaryHeader parseBinaryHeader(string_view header, size_t numberCount, const string &fileName);
+
+    void writeBinaryPieces(const string &fileName, const vector<pair<uint32_t, uint32_t> > &pieces, bool withCounts);
+
+    template<typename Func>
+    void decodeBinaryRecords(string_view records, const BinaryHeader &header, const string &fileName,
+                             Func &&function);
+
+    template<typename Func>
+    void readBinaryPieces(const string &fileName, size_t numberCount, Func &&function);
+
+    template<typename Func>
+    void bufferBinaryPieces(string_view content, size_t numberCount, const string &fileName, Func &&function);
+}
+
+#endif // BINARY_PIECES_HPP
+#include "BinaryPieces.inl"
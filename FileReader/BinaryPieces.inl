@@ -0,0 +1,109 @@
+/**
+ * @file BinaryPieces.inl
+ * @brief This file contains the implementation of the template functions of the binary piece format.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef BINARY_PIECES_INL
+#define BINARY_PIECES_INL
+
+#include <algorithm>
+#include <fstream>
+
+namespace reader {
+    /**
+     * @brief Template function to decode records of a binary piece file.
+     *
+     * Records are only shifted and masked, there is no parsing.
+     * If a key is out of range, it throws a BracedException with a specific error message.
+     *
+     * @tparam Func The type of the function.
+     * @param records Whole records.
+     * @param header The header of the file.
+     * @param fileName The name of the file, for error messages.
+     * @param function The function that receives the key and the multiplicity of every record.
+     */
+    template<typename Func>
+    void decodeBinaryRecords(const string_view records, const BinaryHeader &header, const string &fileName,
+                             Func &&function) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(records.data());
+        const size_t recordSize = header.recordSize();
+        // Keys of pieces of three two-digit numbers
+        constexpr uint32_t keyLimit = 100 * 100 * 100;
+
+        for (size_t i = 0; i + recordSize <= records.size(); i += recordSize) {
+            uint32_t value = bytes[i] | bytes[i + 1] << 8 | bytes[i + 2] << 16;
+            uint32_t count = 1;
+            if (header.hasCounts) {
+                value |= static_cast<uint32_t>(bytes[i + 3]) << 24;
+                count = value >> BINARY_KEY_BITS;
+                value &= (1u << BINARY_KEY_BITS) - 1;
+            }
+
+            if (value >= keyLimit || count == 0)
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+            function(static_cast<size_t>(value), count);
+        }
+    }
+
+    /**
+     * @brief Template function to read a binary piece file.
+     *
+     * The file is read in big blocks of whole records, so the used memory doesn't depend on its size.
+     * If the file can't be opened or is damaged, it throws a BracedException with a specific error message.
+     *
+     * @tparam Func The type of the function.
+     * @param fileName The name of the file.
+     * @param numberCount The expected number of numbers in a piece.
+     * @param function The function that receives the key and the multiplicity of every record.
+     */
+    template<typename Func>
+    void readBinaryPieces(const string &fileName, const size_t numberCount, Func &&function) {
+        ifstream in(fileName, ios::binary);
+        if (!in.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        char headerBytes[BINARY_HEADER_SIZE];
+        if (!in.read(headerBytes, BINARY_HEADER_SIZE))
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+        const BinaryHeader header = parseBinaryHeader({headerBytes, BINARY_HEADER_SIZE}, numberCount, fileName);
+
+        // 64K records per read
+        const size_t recordSize = header.recordSize();
+        vector<char> block(recordSize * 65536);
+        uint64_t recordsLeft = header.recordCount;
+
+        while (recordsLeft != 0) {
+            const size_t records = static_cast<size_t>(std::min<uint64_t>(recordsLeft, 65536));
+            if (!in.read(block.data(), static_cast<streamsize>(records * recordSize)))
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+
+            decodeBinaryRecords({block.data(), records * recordSize}, header, fileName, function);
+            recordsLeft -= records;
+        }
+    }
+
+    /**
+     * @brief Template function to decode a binary piece file that is already in memory.
+     *
+     * If the content is damaged, it throws a BracedException with a specific error message.
+     *
+     * @tparam Func The type of the function.
+     * @param content The content of the file.
+     * @param numberCount The expected number of numbers in a piece.
+     * @param fileName The name of the file, for error messages.
+     * @param function The function that receives the key and the multiplicity of every record.
+     */
+    template<typename Func>
+    void bufferBinaryPieces(const string_view content, const size_t numberCount, const string &fileName,
+                            Func &&function) {
+        const BinaryHeader header = parseBinaryHeader(content, numberCount, fileName);
+        const string_view records = content.substr(BINARY_HEADER_SIZE);
+
+        if (records.size() != header.recordCount * header.recordSize())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BINARY_INVALID], fileName);
+        decodeBinaryRecords(records, header, fileName, function);
+    }
+}
+#endif // BINARY_PIECES_INL
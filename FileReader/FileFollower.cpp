@@ -0,0 +1,63 @@
+/**
+ * @file FileFollower.cpp
+ * @brief This file contains the implementation of the FileFollower class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "FileFollower.hpp"
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+
+namespace reader {
+    ERRORS_
+    BR_EXCEPT_
+
+    /**
+     * @brief Opens a file for following.
+     *
+     * If the file can't be opened, it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the file.
+     */
+    FileFollower::FileFollower(const string &fileName)
+        : fileName_(fileName),
+          in_(fileName, ios::binary) {
+        if (!in_.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+    }
+
+    /**
+     * @brief Reads the bytes appended to the file since the last call.
+     *
+     * After every chunk the handler receives the lines completed in it, without the last line break,
+     * so it isn't called if no line was completed. Only the last line that isn't complete yet is kept,
+     * so the memory doesn't depend on the size of the file, and the work depends only on the number of new bytes.
+     *
+     * @param handler The function that receives the new complete lines.
+     * @return The number of new bytes.
+     */
+    size_t FileFollower::poll(const function<void(string_view)> &handler) {
+        // The end of the file was reached by the previous call, the stream must forget it
+        in_.clear();
+        in_.seekg(static_cast<streamoff>(offset_));
+
+        size_t readBytes = 0;
+        char chunk[CHUNK_SIZE];
+        while (in_.read(chunk, CHUNK_SIZE) || in_.gcount() > 0) {
+            const auto chunkSize = static_cast<size_t>(in_.gcount());
+            pending_.append(chunk, chunkSize);
+            readBytes += chunkSize;
+            offset_ += chunkSize;
+
+            const size_t lastBreak = pending_.rfind('\n');
+            if (lastBreak == string::npos)
+                continue;
+
+            handler(string_view(pending_).substr(0, lastBreak));
+            pending_.erase(0, lastBreak + 1);
+        }
+        return readBytes;
+    }
+}
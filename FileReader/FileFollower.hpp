@@ -0,0 +1,60 @@
+/**
+ * @file FileFollower.hpp
+ * @brief This file contains the declaration of the FileFollower class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef FILE_FOLLOWER_HPP
+#define FILE_FOLLOWER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace reader {
+    using namespace std;
+
+    /**
+     * @brief Reader of a growing file that returns only the bytes appended since the last call.
+     *
+     * The file stays open, every poll continues at the offset where the previous one stopped.
+     * A line without a line break at the end may still be written, so it is kept until the rest of it arrives.
+     */
+    class FileFollower {
+    public:
+        /**
+         * @brief Size of one read.
+         */
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        explicit FileFollower(const string &fileName);
+
+        size_t poll(const function<void(string_view)> &handler);
+
+    private:
+        /**
+         * @brief The name of the file.
+         */
+        string fileName_;
+
+        /**
+         * @brief The open file.
+         */
+        ifstream in_;
+
+        /**
+         * @brief Offset of the first byte that wasn't read yet.
+         */
+        uint64_t offset_ = 0;
+
+        /**
+         * @brief Read bytes of the last line, which isn't complete yet.
+         */
+        string pending_;
+    };
+}
+
+#endif // FILE_FOLLOWER_HPP
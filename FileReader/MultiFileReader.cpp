@@ -0,0 +1,480 @@
+/**
+ * @file MultiFileReader.cpp
+ * @brief This file contains the implementation of functions for reading many files at once.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "MultiFileReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <thread>
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+#include "../Trace/Trace.hpp"
+
+#ifdef BAD_HAVE_IO_URING
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace reader {
+    ERRORS_
+    BR_EXCEPT_
+
+    namespace {
+        /**
+         * @brief Maximum number of files read at the same time.
+         */
+        constexpr size_t QUEUE_DEPTH = 64;
+
+        /**
+         * @brief Size of one read buffer, small piece files fit into one read.
+         */
+        constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * @brief Reports a file that couldn't be read and continues with the others.
+         *
+         * @param fileName The name of the file.
+         */
+        void reportFile(const string &fileName) {
+            cerr << exceptionInFunction("readFiles", ERROR_MESSAGES[FILE_NOT_OPENED], fileName).what() << endl;
+        }
+
+#ifdef BAD_HAVE_IO_URING
+        /**
+         * @brief Minimal io_uring instance, made with raw system calls so liburing isn't needed.
+         */
+        class IoUring {
+        public:
+            IoUring(const size_t entries, vector<iovec> &buffers) {
+                io_uring_params params{};
+                fd_ = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(entries), &params));
+                if (fd_ < 0)
+                    return;
+
+                // Mapping submission and completion rings and submission entries
+                sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                if (params.features & IORING_FEAT_SINGLE_MMAP)
+                    sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+
+                sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               fd_, IORING_OFF_SQ_RING);
+                cqRing_ = params.features & IORING_FEAT_SINGLE_MMAP
+                              ? sqRing_
+                              : mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     fd_, IORING_OFF_CQ_RING);
+                sqes_ = static_cast<io_uring_sqe *>(
+                    mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+                sqeCount_ = params.sq_entries;
+                if (sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+                    release();
+                    return;
+                }
+
+                auto *sq = static_cast<char *>(sqRing_);
+                auto *cq = static_cast<char *>(cqRing_);
+                sqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                sqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                sqArray_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+                cqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                cqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                cqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+                // Buffers are registered once and reused by every read
+                if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                            buffers.data(), static_cast<unsigned>(buffers.size())) < 0)
+                    release();
+            }
+
+            ~IoUring() {
+                release();
+            }
+
+            IoUring(const IoUring &) = delete;
+
+            IoUring &operator=(const IoUring &) = delete;
+
+            /**
+             * @brief Returns true if the ring is ready.
+             */
+            bool isValid() const {
+                return fd_ >= 0;
+            }
+
+            /**
+             * @brief Queues an asynchronous open of a file.
+             */
+            void prepareOpen(const char *path, const uint64_t userData) {
+                io_uring_sqe &sqe = nextEntry();
+                sqe.opcode = IORING_OP_OPENAT;
+                sqe.fd = AT_FDCWD;
+                sqe.addr = reinterpret_cast<uint64_t>(path);
+                sqe.open_flags = O_RDONLY | O_CLOEXEC;
+                sqe.user_data = userData;
+            }
+
+            /**
+             * @brief Queues an asynchronous read into a registered buffer.
+             */
+            void prepareRead(const int fd, const iovec &buffer, const uint16_t bufferIndex,
+                             const uint64_t offset, const uint64_t userData) {
+                io_uring_sqe &sqe = nextEntry();
+                sqe.opcode = IORING_OP_READ_FIXED;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(buffer.iov_base);
+                sqe.len = static_cast<uint32_t>(buffer.iov_len);
+                sqe.off = offset;
+                sqe.buf_index = bufferIndex;
+                sqe.user_data = userData;
+            }
+
+            /**
+             * @brief Submits queued entries and waits for at least one completion.
+             *
+             * The kernel may take fewer entries than queued and doesn't wait then,
+             * the rest stay in the ring and are submitted again.
+             *
+             * @return False if the kernel rejected the submission.
+             */
+            bool submitAndWait() {
+                while (true) {
+                    const long result = syscall(__NR_io_uring_enter, fd_, pending_, 1u, IORING_ENTER_GETEVENTS,
+                                                nullptr, 0);
+                    if (result < 0) {
+                        if (errno != EINTR)
+                            return false;
+                        continue;
+                    }
+                    pending_ -= static_cast<unsigned>(result);
+                    inFlight_ += static_cast<unsigned>(result);
+                    if (pending_ == 0)
+                        return true;
+                }
+            }
+
+            /**
+             * @brief Waits for every submitted entry and calls a function for its completion.
+             *
+             * Entries that were queued but not submitted are never submitted.
+             */
+            template<typename Func>
+            void drain(Func &&function) {
+                while (true) {
+                    forEachCompletion(function);
+                    if (inFlight_ == 0)
+                        return;
+                    if (syscall(__NR_io_uring_enter, fd_, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                        errno != EINTR)
+                        return;
+                }
+            }
+
+            /**
+             * @brief Calls a function for every available completion and releases them.
+             */
+            template<typename Func>
+            void forEachCompletion(Func &&function) {
+                unsigned head = *cqHead_;
+                const unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+                for (; head != tail; ++head) {
+                    const io_uring_cqe cqe = cqes_[head & cqMask_];
+                    // The slot is released before handling, so the handler can queue new entries
+                    __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+                    --inFlight_;
+                    function(cqe.user_data, cqe.res);
+                }
+            }
+
+        private:
+            io_uring_sqe &nextEntry() {
+                const unsigned tail = *sqTail_;
+                const unsigned index = tail & sqMask_;
+                io_uring_sqe &sqe = sqes_[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqArray_[index] = index;
+                __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+                ++pending_;
+                return sqe;
+            }
+
+            void release() {
+                if (sqes_ && sqes_ != MAP_FAILED)
+                    munmap(sqes_, sqeCount_ * sizeof(io_uring_sqe));
+                if (cqRing_ && cqRing_ != MAP_FAILED && cqRing_ != sqRing_)
+                    munmap(cqRing_, cqRingSize_);
+                if (sqRing_ && sqRing_ != MAP_FAILED)
+                    munmap(sqRing_, sqRingSize_);
+                if (fd_ >= 0)
+                    close(fd_);
+                sqes_ = nullptr;
+                sqRing_ = cqRing_ = nullptr;
+                fd_ = -1;
+            }
+
+            int fd_ = -1;
+            void *sqRing_ = nullptr;
+            void *cqRing_ = nullptr;
+            size_t sqRingSize_ = 0;
+            size_t cqRingSize_ = 0;
+            io_uring_sqe *sqes_ = nullptr;
+            unsigned sqeCount_ = 0;
+            unsigned *sqTail_ = nullptr;
+            unsigned sqMask_ = 0;
+            unsigned *sqArray_ = nullptr;
+            unsigned *cqHead_ = nullptr;
+            unsigned *cqTail_ = nullptr;
+            unsigned cqMask_ = 0;
+            io_uring_cqe *cqes_ = nullptr;
+            unsigned pending_ = 0;
+            unsigned inFlight_ = 0;
+        };
+
+        /**
+         * @brief Reads files through io_uring.
+         *
+         * Every slot owns one registered buffer and reads one file at a time: an open is submitted,
+         * its completion submits a read, reads go on until one returns nothing (the kernel may return
+         * fewer bytes than asked before the end), and the file is handed to the handler
+         * before the slot takes the next file. Up to QUEUE_DEPTH files are in flight.
+         *
+         * @return False if io_uring isn't available, or the kernel can't open files through it,
+         * nothing is handed to the handler in that case.
+         */
+        bool readFilesUring(const vector<string> &fileNames, const FileHandler &handler) {
+            struct Slot {
+                size_t file = 0; ///< Index of the file.
+                int fd = -1; ///< Descriptor of the opened file.
+                uint64_t offset = 0; ///< Offset of the next read.
+                string content; ///< Content of the file read so far.
+            };
+
+            const size_t depth = std::min(QUEUE_DEPTH, fileNames.size());
+            vector<char> memory(depth * BUFFER_SIZE);
+            vector<iovec> buffers(depth);
+            for (size_t i = 0; i < depth; ++i)
+                buffers[i] = {memory.data() + i * BUFFER_SIZE, BUFFER_SIZE};
+
+            IoUring ring(depth, buffers);
+            if (!ring.isValid())
+                return false;
+
+            vector<Slot> slots(depth);
+            size_t nextFile = 0;
+            size_t active = 0;
+            bool handled = false;
+
+            // user data keeps the slot and the kind of the operation
+            constexpr uint64_t READ_FLAG = 1;
+
+            // However the reading ends, f.e. when the handler throws, the submitted operations are completed
+            // before the files are closed and the buffers are freed
+            struct SlotCloser {
+                IoUring &ring;
+                vector<Slot> &slots;
+
+                ~SlotCloser() {
+                    ring.drain([&](const uint64_t userData, const int result) {
+                        if (!(userData & READ_FLAG) && result >= 0)
+                            slots[userData >> 1].fd = result;
+                    });
+                    for (const Slot &slot: slots)
+                        if (slot.fd >= 0)
+                            close(slot.fd);
+                }
+            } closer{ring, slots};
+            auto startNext = [&](const size_t slot) {
+                if (nextFile == fileNames.size())
+                    return;
+                slots[slot] = {nextFile, -1, 0, {}};
+                ring.prepareOpen(fileNames[nextFile].c_str(), slot << 1);
+                ++nextFile;
+                ++active;
+            };
+
+            for (size_t slot = 0; slot < depth; ++slot)
+                startNext(slot);
+
+            bool unsupported = false;
+            while (active > 0 && !unsupported) {
+                if (!ring.submitAndWait())
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[READ_FAILED], strerror(errno));
+
+                ring.forEachCompletion([&](const uint64_t userData, const int result) {
+                    const size_t slotIndex = userData >> 1;
+                    Slot &slot = slots[slotIndex];
+                    if (unsupported) {
+                        // Files opened in the same batch are closed with the slots, the rest are drained
+                        if (!(userData & READ_FLAG) && result >= 0)
+                            slot.fd = result;
+                        return;
+                    }
+
+                    // Open is completed, the first read starts
+                    if (!(userData & READ_FLAG)) {
+                        // Kernels older than 5.6 have io_uring without opens, the thread pool reads everything
+                        if (!handled && (result == -EINVAL || result == -EOPNOTSUPP)) {
+                            unsupported = true;
+                            return;
+                        }
+                        if (result < 0) {
+                            reportFile(fileNames[slot.file]);
+                            --active;
+                            startNext(slotIndex);
+                            return;
+                        }
+                        slot.fd = result;
+                        ring.prepareRead(slot.fd, buffers[slotIndex], static_cast<uint16_t>(slotIndex), 0,
+                                         userData | READ_FLAG);
+                        return;
+                    }
+
+                    if (result < 0) {
+                        reportFile(fileNames[slot.file]);
+                    } else if (result > 0) {
+                        // Any read but an empty one may be followed by more bytes
+                        slot.content.append(static_cast<const char *>(buffers[slotIndex].iov_base),
+                                            static_cast<size_t>(result));
+                        slot.offset += static_cast<uint64_t>(result);
+                        ring.prepareRead(slot.fd, buffers[slotIndex], static_cast<uint16_t>(slotIndex),
+                                         slot.offset, userData);
+                        return;
+                    } else {
+                        trace::TraceScope traceParse("parseFile", slot.file);
+                        handled = true;
+                        handler(slot.file, slot.content);
+                    }
+                    close(slot.fd);
+                    slot.fd = -1;
+                    --active;
+                    startNext(slotIndex);
+                });
+            }
+            return !unsupported;
+        }
+#endif
+
+        /**
+         * @brief Reads files in worker threads and hands them to the handler in the calling thread.
+         *
+         * Workers take files by an atomic counter and read them with blocking calls,
+         * the calling thread parses files in the order of completion.
+         */
+        void readFilesThreadPool(const vector<string> &fileNames, const FileHandler &handler) {
+            struct Result {
+                size_t file; ///< Index of the file.
+                optional<string> content; ///< Content, empty if the file couldn't be opened.
+            };
+
+            mutex queueMutex;
+            condition_variable queueCondition;
+            queue<Result> results;
+            atomic<size_t> nextFile = 0;
+
+            const size_t workerCount = std::max<size_t>(
+                1, std::min<size_t>(thread::hardware_concurrency(), fileNames.size()));
+            vector<jthread> workers;
+            workers.reserve(workerCount);
+
+            for (size_t i = 0; i < workerCount; ++i)
+                workers.emplace_back([&] {
+                    for (size_t file = nextFile++; file < fileNames.size(); file = nextFile++) {
+                        trace::TraceScope traceRead("readFile", file);
+                        Result result{file, nullopt};
+                        ifstream in(fileNames[file], ios::binary);
+                        if (in.is_open()) {
+                            ostringstream content;
+                            content << in.rdbuf();
+                            result.content = std::move(content).str();
+                        }
+                        {
+                            lock_guard lock(queueMutex);
+                            results.push(std::move(result));
+                        }
+                        queueCondition.notify_one();
+                    }
+                });
+
+            for (size_t handled = 0; handled < fileNames.size(); ++handled) {
+                unique_lock lock(queueMutex);
+                queueCondition.wait(lock, [&] { return !results.empty(); });
+                Result result = std::move(results.front());
+                results.pop();
+                lock.unlock();
+
+                if (result.content) {
+                    trace::TraceScope traceParse("parseFile", result.file);
+                    handler(result.file, *result.content);
+                } else
+                    reportFile(fileNames[result.file]);
+            }
+        }
+    }
+
+    /**
+     * @brief Function to read many files and hand each one to a handler as soon as it is read.
+     *
+     * On Linux the files are opened and read through io_uring, so the number of requests in flight
+     * grows with the number of files. If io_uring isn't compiled in or the kernel refuses it,
+     * a pool of threads with blocking reads is used. Files that can't be opened are reported and skipped.
+     *
+     * @param fileNames Names of the files to be read.
+     * @param handler The function that receives the content of every file.
+     * @return The backend that was used.
+     */
+    ReadBackend readFiles(const vector<string> &fileNames, const FileHandler &handler) {
+        if (fileNames.empty())
+            return ReadBackend::THREAD_POOL;
+
+#ifdef BAD_HAVE_IO_URING
+        if (readFilesUring(fileNames, handler))
+            return ReadBackend::IO_URING;
+#endif
+        readFilesThreadPool(fileNames, handler);
+        return ReadBackend::THREAD_POOL;
+    }
+
+    /**
+     * @brief Function to read a list of file names, one name per line.
+     *
+     * Empty lines are skipped. If the list can't be opened, it throws a BracedException with a specific error message.
+     *
+     * @param listFileName The name of the file with the list.
+     * @return The names of the files.
+     */
+    vector<string> readFileNames(const string &listFileName) {
+        ifstream in(listFileName);
+
+        // if file is not opened then throw exception
+        if (!in.is_open())
+            throw exceptionInFunction(
+                __FUNCTION__,
+                ERROR_MESSAGES[FILE_NOT_OPENED], listFileName);
+
+        vector<string> fileNames;
+        string line;
+        while (getline(in, line))
+            if (!line.empty())
+                fileNames.push_back(line);
+        return fileNames;
+    }
+}
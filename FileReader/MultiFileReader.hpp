@@ -0,0 +1,40 @@
+/**
+ * @file MultiFileReader.hpp
+ * @brief This file contains the declaration of functions for reading many files at once.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef MULTI_FILE_READER_HPP
+#define MULTI_FILE_READER_HPP
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reader {
+    using namespace std;
+
+    /**
+     * @brief Callback that receives the content of one file as soon as it is read.
+     *
+     * The first argument is the index of the file in the list, the second one is its content.
+     * The content is valid only during the call, because its buffer is reused for the next file.
+     */
+    using FileHandler = function<void(size_t, string_view)>;
+
+    /**
+     * @brief Backends used to read many files.
+     */
+    enum class ReadBackend {
+        IO_URING, ///< Asynchronous opens and reads into registered buffers (Linux).
+        THREAD_POOL, ///< Blocking reads in worker threads.
+    };
+
+    ReadBackend readFiles(const vector<string> &fileNames, const FileHandler &handler);
+
+    vector<string> readFileNames(const string &listFileName);
+}
+
+#endif // MULTI_FILE_READER_HPP
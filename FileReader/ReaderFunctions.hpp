@@ -18,9 +18,13 @@
 #include <map>
 #include <memory>
 #include <array>
+#include <charconv>
+#include <limits>
 
 #include "../ErrorCodeStrings/ErrorCodes.hpp"
 #include "../BracedException/BracedException.hpp"
+#include "MultiFileReader.hpp"
+#include "BinaryPieces.hpp"
 
 namespace reader {
  using namespace std;
@@ -81,9 +85,29 @@ namespace reader {
  template<typename arrayType, size_t vCount, size_t substringSize>
  VertexNumbers<arrayType, vCount> stringToVectorVertex(const string &stringValue);
 
+ template<typename arrayType, size_t vCount, size_t substringSize>
+ array<arrayType, vCount> stringToArray(const string &stringValue);
+
 
  template<typename vType, size_t vCount, size_t stringSize>
  list<VertexNumbers<vType, vCount> > readFileToList(const string &fileName);
+
+ template<typename Func>
+ void forEachLine(string_view content, Func &&function);
+
+ template<typename vType, size_t vCount, size_t stringSize>
+ void bufferToList(string_view content, VertexList<vType, vCount> &lines, const string &fileName = {});
+
+ template<typename vType, size_t vCount, size_t stringSize>
+ list<VertexNumbers<vType, vCount> > readFilesToList(const vector<string> &fileNames);
+
+ constexpr size_t pieceKeyCount(size_t vCount);
+
+ template<typename vType, size_t vCount>
+ size_t pieceKey(const array<vType, vCount> &piece);
+
+ template<typename vType, size_t vCount>
+ array<vType, vCount> pieceFromKey(size_t key);
 }
 
 #endif // READER_FUNCTIONS_HPP
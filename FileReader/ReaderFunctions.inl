@@ -12,7 +12,8 @@ namespace reader {
     /**
      * @brief Template function to convert a string to a numeric value.
      *
-     * This function converts a string to a numeric value using stringstream.
+     * This function converts a string to a numeric value using from_chars, which doesn't allocate,
+     * unlike a stringstream. A value too big for the type becomes its maximum.
      * If the string contains non-digit symbols, it throws a BracedException with a specific error message.
      *
      * @tparam T The type of the numeric value to be converted.
@@ -21,10 +22,11 @@ namespace reader {
      */
     template<typename T>
     T sto(const string &stringValue) {
-        T val;
+        T val{};
 
-        std::stringstream ss(stringValue);
-        ss >> val;
+        if (from_chars(stringValue.data(), stringValue.data() + stringValue.size(), val).ec ==
+            errc::result_out_of_range)
+            val = numeric_limits<T>::max();
 
         // if found symbols then throw exception
         if (!std::all_of(stringValue.begin(), stringValue.end(), ::isdigit))
@@ -121,16 +123,33 @@ namespace reader {
     template<typename vType, size_t vCount, size_t substringSize>
     VertexNumbers<vType, vCount> stringToVectorVertex(
         const string &stringValue) {
+        return make_shared<array<vType, vCount> >(stringToArray<vType, vCount, substringSize>(stringValue));
+    }
+
+    /**
+     * @brief Template function to convert a string to an array of numeric values.
+     *
+     * This function converts a string to an array of numeric values using the sto function.
+     * It also validates the size of the array and the size of each substring.
+     *
+     * @tparam vType The type of the numeric values in the array.
+     * @tparam vCount The size of the array.
+     * @tparam substringSize The size of each substring.
+     * @param stringValue The string to be converted.
+     * @return The array of numeric values.
+     */
+    template<typename vType, size_t vCount, size_t substringSize>
+    array<vType, vCount> stringToArray(const string &stringValue) {
         //
         tryFunction(__FUNCTION__, arraySizeIsValid, vCount);
         tryFunction(__FUNCTION__, substringSizeIsValid, substringSize);
 
-        VertexNumbers<vType, vCount> vertex = make_shared<array<vType, vCount> >();
+        array<vType, vCount> numbers{};
 
         for (size_t i = 0; i < stringValue.size(); i += substringSize)
-            (*vertex)[i / substringSize] = sto<vType>(stringValue.substr(i, substringSize));
+            numbers[i / substringSize] = sto<vType>(stringValue.substr(i, substringSize));
 
-        return vertex;
+        return numbers;
     }
 
     /**
@@ -139,6 +158,8 @@ namespace reader {
      * This function reads a file line by line, converts each line to a vector of numeric values using the stringToVectorVertex function,
      * and stores the vectors in a list.
      * If any line is invalid, it throws a BracedException with a specific error message and continues processing the remaining lines.
+     * A file in the binary piece format is detected by its signature and loaded without parsing,
+     * a piece with a multiplicity becomes as many elements.
      *
      * @tparam vType The type of the numeric values in the vectors.
      * @tparam vCount The size of the vectors.
@@ -158,6 +179,20 @@ namespace reader {
 
         list<VertexNumbers<vType, vCount> > lines;
 
+        // binary files are decoded, not parsed
+        char magic[sizeof(BINARY_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (isBinaryPieces({magic, static_cast<size_t>(in.gcount())})) {
+            in.close();
+            readBinaryPieces(fileName, vCount, [&](const size_t key, const uint32_t count) {
+                for (uint32_t copy = 0; copy < count; ++copy)
+                    lines.emplace_back(make_shared<array<vType, vCount> >(pieceFromKey<vType, vCount>(key)));
+            });
+            return lines;
+        }
+        in.clear();
+        in.seekg(0);
+
         while (!in.eof()) {
             string line;
 
@@ -177,6 +212,142 @@ namespace reader {
         return lines;
     }
 
+    /**
+     * @brief Template function to call a function for every line of a buffer.
+     *
+     * Lines are split the same way as by a getline loop: the part after the last line break is a line too.
+     *
+     * @tparam Func The type of the function.
+     * @param content The buffer.
+     * @param function The function that receives every line as a string.
+     */
+    template<typename Func>
+    void forEachLine(string_view content, Func &&function) {
+        string line;
+
+        while (true) {
+            const size_t lineEnd = content.find('\n');
+            line.assign(content.substr(0, lineEnd));
+            function(line);
+
+            if (lineEnd == string_view::npos)
+                return;
+            content.remove_prefix(lineEnd + 1);
+        }
+    }
+
+    /**
+     * @brief Template function to parse the content of a file into a list of vectors of numeric values.
+     *
+     * Invalid lines are reported the same way as by readFileToList, binary content is decoded as by readFileToList.
+     *
+     * @tparam vType The type of the numeric values in the vectors.
+     * @tparam vCount The size of the vectors.
+     * @tparam stringSize The size of each line.
+     * @param content The content of a file.
+     * @param lines The list that receives the vectors.
+     * @param fileName The name of the file, for error messages.
+     */
+    template<typename vType, size_t vCount, size_t stringSize>
+    void bufferToList(const string_view content, VertexList<vType, vCount> &lines, const string &fileName) {
+        if (isBinaryPieces(content)) {
+            bufferBinaryPieces(content, vCount, fileName, [&](const size_t key, const uint32_t count) {
+                for (uint32_t copy = 0; copy < count; ++copy)
+                    lines.emplace_back(make_shared<array<vType, vCount> >(pieceFromKey<vType, vCount>(key)));
+            });
+            return;
+        }
+
+        forEachLine(content, [&](const string &line) {
+            // if line is invalid then throw exception and continue
+            try {
+                tryFunction(__FUNCTION__, stringIsValid<vType, stringSize, stringSize / vCount>, line, 0, 99);
+                lines.emplace_back(stringToVectorVertex<vType, vCount, stringSize / vCount>(line));
+            } catch (const BracedException &ex) {
+                cerr << ex.what() << endl;
+            }
+        });
+    }
+
+    /**
+     * @brief Template function to read many files and convert their content to one list of vectors of numeric values.
+     *
+     * Files are read asynchronously by readFiles, and every file is parsed as soon as its read completes.
+     * Every file has its own list, the lists are joined in the order of fileNames, so the result
+     * doesn't depend on the order of completion.
+     *
+     * @tparam vType The type of the numeric values in the vectors.
+     * @tparam vCount The size of the vectors.
+     * @tparam stringSize The size of each line in the files.
+     * @param fileNames The names of the files to be read.
+     * @return A list of shared pointers to the vectors of numeric values.
+     */
+    template<typename vType, size_t vCount, size_t stringSize>
+    list<VertexNumbers<vType, vCount> > readFilesToList(const vector<string> &fileNames) {
+        vector<VertexList<vType, vCount> > fileLines(fileNames.size());
+
+        readFiles(fileNames, [&](const size_t file, const string_view content) {
+            // a damaged binary file is reported, the other files are still read
+            try {
+                bufferToList<vType, vCount, stringSize>(content, fileLines[file], fileNames[file]);
+            } catch (const BracedException &ex) {
+                cerr << ex.what() << endl;
+            }
+        });
+
+        list<VertexNumbers<vType, vCount> > lines;
+        for (auto &oneFileLines: fileLines)
+            lines.splice(lines.end(), oneFileLines);
+        return lines;
+    }
+
+    /**
+     * @brief Function to calculate the number of all possible pieces.
+     *
+     * @param vCount The number of two-digit numbers in a piece.
+     * @return 100 to the power of vCount.
+     */
+    constexpr size_t pieceKeyCount(const size_t vCount) {
+        size_t count = 1;
+        for (size_t i = 0; i < vCount; ++i)
+            count *= 100;
+        return count;
+    }
+
+    /**
+     * @brief Template function to calculate a unique key of a piece.
+     *
+     * The numbers of the piece are treated as digits of a base 100 number, f.e. [56,12,34] -> 561234.
+     *
+     * @tparam vType The type of the numeric values in the piece.
+     * @tparam vCount The number of the numeric values in the piece.
+     * @param piece The piece.
+     * @return The key of the piece.
+     */
+    template<typename vType, size_t vCount>
+    size_t pieceKey(const array<vType, vCount> &piece) {
+        size_t key = 0;
+        for (const vType &number: piece)
+            key = key * 100 + static_cast<size_t>(number);
+        return key;
+    }
+
+    /**
+     * @brief Template function to restore a piece from its key.
+     *
+     * @tparam vType The type of the numeric values in the piece.
+     * @tparam vCount The number of the numeric values in the piece.
+     * @param key The key calculated by pieceKey.
+     * @return The piece.
+     */
+    template<typename vType, size_t vCount>
+    array<vType, vCount> pieceFromKey(size_t key) {
+        array<vType, vCount> piece;
+        for (size_t i = vCount; i-- > 0; key /= 100)
+            piece[i] = static_cast<vType>(key % 100);
+        return piece;
+    }
+
     /**
      * @brief Template function to convert a list of vectors of numeric values to a map of numeric values and vectors.
      *
@@ -0,0 +1,117 @@
+/**
+ * @file Generator.hpp
+ * @brief This file contains the declaration of the Generator class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief Namespace for coroutine helpers.
+ */
+namespace generator {
+    using namespace std;
+
+    /**
+     * @brief Lazy sequence of values produced by a coroutine with co_yield.
+     *
+     * The coroutine runs only while the next value is requested, so a caller can stop at any value
+     * by leaving the loop, the coroutine is destroyed together with the generator.
+     *
+     * @tparam T The type of the values.
+     */
+    template<typename T>
+    class Generator {
+    public:
+        /**
+         * @brief Promise type of the coroutine, keeps the last yielded value.
+         */
+        struct promise_type {
+            optional<T> value_;
+            exception_ptr exception_;
+
+            Generator get_return_object();
+
+            suspend_always initial_suspend() noexcept { return {}; }
+
+            suspend_always final_suspend() noexcept { return {}; }
+
+            suspend_always yield_value(T value);
+
+            void return_void() noexcept {
+            }
+
+            void unhandled_exception() noexcept { exception_ = current_exception(); }
+        };
+
+        using Handle = coroutine_handle<promise_type>;
+
+        /**
+         * @brief Input iterator over the values, resumes the coroutine on increment.
+         */
+        class iterator {
+        public:
+            using iterator_category = input_iterator_tag;
+            using difference_type = ptrdiff_t;
+            using value_type = T;
+
+            iterator() = default;
+
+            explicit iterator(const Handle handle)
+                : handle_(handle) {
+            }
+
+            T &operator*() const { return *handle_.promise().value_; }
+
+            iterator &operator++();
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(default_sentinel_t) const { return !handle_ || handle_.done(); }
+
+        private:
+            Handle handle_;
+        };
+
+        explicit Generator(const Handle handle)
+            : handle_(handle) {
+        }
+
+        Generator(Generator &&other) noexcept
+            : handle_(std::exchange(other.handle_, {})) {
+        }
+
+        Generator &operator=(Generator &&other) noexcept;
+
+        Generator(const Generator &) = delete;
+
+        Generator &operator=(const Generator &) = delete;
+
+        ~Generator();
+
+        iterator begin();
+
+        default_sentinel_t end() const { return default_sentinel; }
+
+    private:
+        Handle handle_;
+
+        static void resume(Handle handle);
+    };
+}
+
+/**
+ * @brief Macro to simplify the use of the generator namespace.
+ */
+#define GENERATOR_ using namespace generator;
+
+#endif // GENERATOR_HPP
+#include "Generator.inl"
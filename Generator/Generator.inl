@@ -0,0 +1,86 @@
+/**
+ * @file Generator.inl
+ * @brief This file contains the implementation of the Generator class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef GENERATOR_INL
+#define GENERATOR_INL
+
+namespace generator {
+    /**
+     * @brief Creates the generator that owns the coroutine.
+     */
+    template<typename T>
+    Generator<T> Generator<T>::promise_type::get_return_object() {
+        return Generator(Handle::from_promise(*this));
+    }
+
+    /**
+     * @brief Saves a yielded value and suspends the coroutine.
+     *
+     * @param value The yielded value.
+     */
+    template<typename T>
+    suspend_always Generator<T>::promise_type::yield_value(T value) {
+        value_ = std::move(value);
+        return {};
+    }
+
+    /**
+     * @brief Resumes the coroutine until the next value or the end.
+     *
+     * An exception thrown by the coroutine is thrown again here, in the caller.
+     *
+     * @param handle The coroutine.
+     */
+    template<typename T>
+    void Generator<T>::resume(const Handle handle) {
+        handle.resume();
+        if (handle.promise().exception_)
+            rethrow_exception(std::exchange(handle.promise().exception_, nullptr));
+    }
+
+    /**
+     * @brief Moves to the next value.
+     */
+    template<typename T>
+    typename Generator<T>::iterator &Generator<T>::iterator::operator++() {
+        resume(handle_);
+        return *this;
+    }
+
+    /**
+     * @brief Takes the coroutine of another generator, destroying the current one.
+     */
+    template<typename T>
+    Generator<T> &Generator<T>::operator=(Generator &&other) noexcept {
+        if (this != &other) {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the coroutine, a suspended coroutine is cancelled this way.
+     */
+    template<typename T>
+    Generator<T>::~Generator() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    /**
+     * @brief Starts the coroutine and returns an iterator at its first value.
+     */
+    template<typename T>
+    typename Generator<T>::iterator Generator<T>::begin() {
+        if (handle_)
+            resume(handle_);
+        return iterator(handle_);
+    }
+}
+#endif // GENERATOR_INL
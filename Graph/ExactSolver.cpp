@@ -0,0 +1,94 @@
+/**
+ * @file ExactSolver.cpp
+ * @brief This file contains the implementation of the ExactSolver class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "ExactSolver.hpp"
+
+#include <bit>
+
+namespace graph {
+    /**
+     * @brief Prepares the solver for a component, forgetting all arcs.
+     *
+     * @param pieceCount The number of pieces, at most MAX_PIECES.
+     */
+    void ExactSolver::reset(const size_t pieceCount) {
+        successors_.assign(pieceCount, 0);
+    }
+
+    /**
+     * @brief Adds an arc between two pieces, the second one may follow the first one.
+     *
+     * @param from The earlier piece.
+     * @param to The later piece.
+     */
+    void ExactSolver::addArc(const size_t from, const size_t to) {
+        successors_[from] |= Mask{1} << to;
+    }
+
+    /**
+     * @brief Finds the longest path through the pieces, every piece is used once at most.
+     *
+     * Sets are filled in ascending order, so a set is complete before any of its supersets is reached:
+     * a piece p starts a path over the set S + p if one of its successors starts a path over S.
+     * Of equally long paths the one whose first piece has the smallest priority wins.
+     *
+     * @param priorities The priority of every piece as a start, the smaller the better.
+     * @param path The vector that receives the pieces of the path in order.
+     * @return The number of pieces in the path.
+     */
+    size_t ExactSolver::solve(const vector<uint32_t> &priorities, vector<uint32_t> &path) {
+        const size_t pieceCount = successors_.size();
+        path.clear();
+        if (pieceCount == 0)
+            return 0;
+
+        const Mask full = static_cast<Mask>((uint64_t{1} << pieceCount) - 1);
+        firsts_.assign(static_cast<size_t>(full) + 1, 0);
+        for (size_t piece = 0; piece < pieceCount; ++piece)
+            firsts_[Mask{1} << piece] = Mask{1} << piece;
+
+        size_t bestLength = 0;
+        uint32_t bestFirst = 0;
+        Mask bestMask = 0;
+
+        for (Mask mask = 1; mask <= full; ++mask) {
+            const Mask firsts = firsts_[mask];
+            if (firsts == 0)
+                continue;
+
+            // The best first piece of the set, compared only when the set is at least as long as the best
+            const auto length = static_cast<size_t>(popcount(mask));
+            if (length >= bestLength)
+                for (Mask rest = firsts; rest != 0; rest &= rest - 1) {
+                    const auto piece = static_cast<uint32_t>(countr_zero(rest));
+                    if (length > bestLength || priorities[piece] < priorities[bestFirst]) {
+                        bestLength = length;
+                        bestFirst = piece;
+                        bestMask = mask;
+                    }
+                }
+
+            // Every unused piece with a successor among the firsts extends the set
+            for (Mask unused = full & ~mask; unused != 0; unused &= unused - 1) {
+                const auto piece = countr_zero(unused);
+                if (successors_[piece] & firsts)
+                    firsts_[mask | Mask{1} << piece] |= Mask{1} << piece;
+            }
+        }
+
+        // Walking forward, the next piece is a successor that starts a path over the remaining set
+        uint32_t piece = bestFirst;
+        for (Mask mask = bestMask;;) {
+            path.push_back(piece);
+            mask &= ~(Mask{1} << piece);
+            if (mask == 0)
+                break;
+            piece = static_cast<uint32_t>(countr_zero(successors_[piece] & firsts_[mask]));
+        }
+        return bestLength;
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file ExactSolver.hpp
+ * @brief This file contains the declaration of the ExactSolver class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef EXACT_SOLVER_HPP
+#define EXACT_SOLVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace graph {
+    using namespace std;
+
+    /**
+     * @brief Exact longest path of a small component by dynamic programming over sets of used pieces.
+     *
+     * Every piece of the component is one bit, identical pieces are separate bits. For every set of pieces
+     * the table keeps the set of pieces that can start a path using exactly these pieces, so the table
+     * has 2^n words and is filled in O(2^n * n) bit operations, instead of trying every path.
+     * The table is kept between calls, so a solver reused for many components allocates only once.
+     */
+    class ExactSolver {
+    public:
+        /**
+         * @brief The biggest number of pieces of a component the solver accepts, the table takes 4 MB then.
+         */
+        static constexpr size_t MAX_PIECES = 20;
+
+        /**
+         * @brief Set of pieces, bit i is the piece i.
+         */
+        using Mask = uint32_t;
+
+        void reset(size_t pieceCount);
+
+        void addArc(size_t from, size_t to);
+
+        size_t solve(const vector<uint32_t> &priorities, vector<uint32_t> &path);
+
+    private:
+        /**
+         * @brief Pieces that can follow every piece.
+         */
+        vector<Mask> successors_;
+
+        /**
+         * @brief Pieces that can start a path using exactly the pieces of the index.
+         */
+        vector<Mask> firsts_;
+    };
+}
+
+#endif // EXACT_SOLVER_HPP
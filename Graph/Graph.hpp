@@ -9,12 +9,40 @@
 #define GRAPH_HPP
 
 #include "../Vertex/Vertex.hpp"
+#include "../PieceTable/PieceTable.hpp"
+#include "../Generator/Generator.hpp"
+#include "JunctionClosure.hpp"
+#include "ExactSolver.hpp"
+#include "Solver.hpp"
+#include "../Checkpoint/Checkpoint.hpp"
+#include "../Trace/Trace.hpp"
+#include "../Allocation/Allocation.hpp"
 #include <functional>
-#include <unordered_set>
+#include <unordered_map>
 #include <cmath>
+#include <cstdint>
+#include <span>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <stop_token>
+#include <condition_variable>
+#include <iostream>
 #include <utility>
 
 namespace graph {
+    GENERATOR_
+
+    /**
+     * @brief A combination found by the search, with the progress of the search at that moment.
+     */
+    struct Solution {
+        string combination; ///< The puzzle combination.
+        size_t length; ///< Number of pieces in the combination.
+        size_t startsSearched; ///< Number of start vertices searched, including the current one.
+        size_t startCount; ///< Number of all start vertices.
+    };
+
     /**
      * @brief Represents a graph data structure.
      *
@@ -28,37 +56,224 @@ namespace graph {
          * @brief Constructs a new graph with the given vertices.
          *
          * @param vertices A vector of shared pointers to vertex objects.
+         * @param implicitEdges Find neighbors in junction buckets instead of edge lists of the vertices.
          */
-        explicit Graph(const vector<shared_ptr<Vertex<vType, vCount> > > &vertices)
-            : vertices_(vertices) {
+        explicit Graph(const vector<shared_ptr<Vertex<vType, vCount> > > &vertices, const bool implicitEdges = false)
+            : vertices_(vertices),
+              implicitEdges_(implicitEdges) {
+            buildIndex();
         }
 
     private:
+        /**
+         * @brief Marker for a missing vertex, record or slot index.
+         */
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        /**
+         * @brief Number of DFS steps between checks of a stop request.
+         */
+        static constexpr uint32_t STOP_CHECK_INTERVAL = 4096;
+
+        /**
+         * @brief One entry of the explicit DFS stack.
+         *
+         * Replaces a call of the old recursive helper: it remembers the vertex being expanded,
+         * the position in its adjacency and the longest child path found so far.
+         */
+        struct SearchFrame {
+            uint32_t vertex; ///< Index of the expanded vertex.
+            uint32_t cursor; ///< Position of the next neighbor to try.
+            uint32_t bestLength; ///< Length (in pieces) of the longest child path.
+            uint32_t bestRecord; ///< Record of the child that starts the longest path.
+            uint32_t record; ///< Record of this expansion.
+        };
+
+        /**
+         * @brief State of one running search: visited slots, the DFS stack and expansion records.
+         *
+         * Every thread has its own state, the graph itself isn't changed by the search.
+         */
+        struct SearchState {
+            vector<uint32_t> slotStamps; ///< Epoch of the last visit of every slot.
+            vector<uint32_t> slotUses; ///< Number of uses of every slot in the current epoch.
+            uint32_t epoch = 0; ///< Current epoch, bumped to forget all visits in O(1).
+            vector<SearchFrame> frames; ///< Explicit DFS stack.
+            vector<uint32_t> recordVertices; ///< Vertex of every expansion.
+            vector<uint32_t> recordNext; ///< Record of the best continuation of every expansion.
+            vector<uint32_t> recordParents; ///< Record of the parent of every expansion.
+            vector<uint32_t> recordLengths; ///< Length of the longest path from every expansion.
+            ExactSolver exact; ///< Solver of small components.
+            vector<uint32_t> localSlots; ///< Index of every slot among the slots of the solved component, or NONE.
+            vector<uint32_t> slotUnits; ///< First unit of every slot of the solved component, and the end.
+            vector<uint32_t> unitVertices; ///< Vertex of every piece (unit) of the solved component.
+            vector<uint32_t> unitPriorities; ///< Start position of every unit, the earliest of its slot.
+            vector<uint32_t> unitOrder; ///< Units or slots in the order an engine needs.
+            vector<uint32_t> unitValues; ///< Value of every unit or slot, f.e. its path length.
+            vector<uint32_t> unitPath; ///< Units of the path found by an engine.
+        };
+
+        /**
+         * @brief Weakly connected component, the unit of parallel work.
+         *
+         * Its profile chooses the engine that solves it.
+         */
+        struct Component : ComponentProfile {
+            vector<uint32_t> starts; ///< Positions in order_ of the vertices of the component, ascending.
+        };
+
         /**
          * @brief A vector of shared pointers to vertex objects.
          */
         vector<shared_ptr<Vertex<vType, vCount> > > vertices_;
 
+        /**
+         * @brief Neighbors are junction buckets, vertices don't have edge lists.
+         */
+        bool implicitEdges_ = false;
+
+        /**
+         * @brief Adjacency in compressed sparse row form, indexed by vertex position in vertices_.
+         */
+        vector<size_t> edgeOffsets_;
+        vector<uint32_t> edgeTargets_;
+
+        /**
+         * @brief Vertices grouped by their first number, for implicit edges.
+         *
+         * Bucket j is bucketVertices_[bucketOffsets_[j], bucketOffsets_[j + 1]), in the order of vertices_,
+         * the same order in which createGraph adds edges.
+         */
+        vector<uint32_t> bucketOffsets_;
+        vector<uint32_t> bucketVertices_;
+
+        /**
+         * @brief Distinct piece (slot) of every vertex. Equal pieces share a slot.
+         */
+        vector<uint32_t> slots_;
+
+        /**
+         * @brief How many times a slot may appear in one combination (the number of identical pieces).
+         */
+        vector<uint32_t> slotLimits_;
+
+        /**
+         * @brief Start order of the vertices, filled by sortByEdgeCount().
+         */
+        vector<uint32_t> order_;
+
+        /**
+         * @brief Weakly connected components of the graph, found when the graph is built.
+         */
+        vector<Component> components_;
+
+        /**
+         * @brief Number of all pieces in the graph, the length of a path can't be bigger.
+         */
+        size_t pieceCount_ = 0;
+
+        /**
+         * @brief Reachability between junctions through pieces that have edges.
+         */
+        JunctionClosure closure_;
+
+        /**
+         * @brief Number of pieces that can follow a piece ending at every junction.
+         *
+         * These are the pieces that start at the junction or at a junction reachable from it,
+         * so a path from a vertex can't be longer than one plus the bound of its last number.
+         */
+        array<size_t, JunctionClosure::JUNCTIONS> junctionBounds_{};
+
+        /**
+         * @brief Search state used by solutions().
+         */
+        SearchState state_;
+
+        /**
+         * @brief Vertices of the longest path found by the last dfs() call.
+         */
+        vector<uint32_t> bestPath_;
+
+        template<typename T, size_t C>
+        friend class QueryIndex;
+
     public:
-        string dfs();
+        string dfs(size_t threadCount = 0, const CheckpointSettings &checkpoint = {},
+                   SolverKind solver = SolverKind::DFS);
+
+        Generator<Solution> solutions(stop_token stop = {});
+
+        const vector<uint32_t> &bestPath() const;
+
+        size_t spliceCycles();
+
+        size_t componentCount() const { return components_.size(); }
+
+        const JunctionClosure &closure() const { return closure_; }
+
+        size_t lengthBound(uint32_t vertex) const;
+
+        uint64_t fingerprint(uint64_t salt = 0) const;
+
+        string combinationToString(const vector<uint32_t> &path) const;
 
         void puzzleCombinationIsValid(const string &) const;
 
-        static Graph<vType, vCount> createGraph(const map<vType, vector<VertexNumbers<vType, vCount> > > &vData);
+        static Graph<vType, vCount> createGraph(const map<vType, vector<VertexNumbers<vType, vCount> > > &vData,
+                                                bool implicitEdges = false);
 
-        template<typename T, size_t C>
-        friend string to_string(const Graph<T, C> &vertex);
+        static Graph<vType, vCount> createGraph(const map<vType, vector<VertexNumbers<vType, vCount> > > &vData,
+                                                const PieceTable<vType, vCount> &counts, bool implicitEdges = false);
+
+        size_t vertexCount() const { return vertices_.size(); }
+
+        const shared_ptr<Vertex<vType, vCount> > &vertexAt(uint32_t vertex) const { return vertices_[vertex]; }
+
+        span<const uint32_t> neighbors(uint32_t vertex) const;
 
     private:
-        signed long long findVertex(const string &vertex) const;
+        static Graph<vType, vCount> buildGraph(const map<vType, vector<VertexNumbers<vType, vCount> > > &vData,
+                                               const PieceTable<vType, vCount> *counts, bool implicitEdges);
+
+        signed long long findVertex(string_view vertex) const;
+
+        void buildIndex();
+
+        void buildBuckets();
+
+        void buildComponents();
+
+        void buildClosure();
+
+        void buildProfiles();
 
         void sortByEdgeCount();
 
-        double keyGenerator(const std::shared_ptr<Vertex<vType, vCount> > &vertex);
+        static size_t keyGenerator(const std::shared_ptr<Vertex<vType, vCount> > &vertex);
+
+        void initState(SearchState &state) const;
+
+        static void newEpoch(SearchState &state);
+
+        bool enterVertex(SearchState &state, uint32_t vertex) const;
+
+        uint32_t dfsFrom(SearchState &state, uint32_t start, uint32_t &startRecord, const stop_token &stop) const;
+
+        static void collectPath(const SearchState &state, uint32_t record, vector<uint32_t> &path);
+
+        static uint64_t searchKey(size_t length, size_t position);
+
+        void collectUnits(SearchState &state, const Component &component) const;
+
+        size_t solveComponent(SolverKind solver, SearchState &state, const Component &component,
+                              vector<uint32_t> &path, size_t &position) const;
+
+        size_t solveExact(SearchState &state, vector<uint32_t> &path, size_t &position) const;
 
+        size_t solveAcyclic(SearchState &state, vector<uint32_t> &path, size_t &position) const;
 
-        string dfsHelper(const shared_ptr<Vertex<vType, vCount> > &vertex,
-                         unordered_set<double> &visited);
+        size_t solveEuler(SearchState &state, vector<uint32_t> &path, size_t &position) const;
     };
 } // graph
 
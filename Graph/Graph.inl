@@ -6,122 +6,1246 @@
 #define GRAPH_INL
 
 namespace graph {
+    /**
+     * @brief Builds the flat search index of the graph.
+     *
+     * Assigns every vertex its position in vertices_, converts edge lists to compressed sparse rows,
+     * maps equal pieces to one slot, sorts the start order and splits the graph into components.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::buildIndex() {
+        trace::TraceScope traceIndex("buildIndex");
+        const size_t vertexCount = vertices_.size();
+
+        // Positions of vertices for edge translation
+        unordered_map<const Vertex<vType, vCount> *, uint32_t> positions;
+        if (!implicitEdges_) {
+            positions.reserve(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i)
+                positions.emplace(vertices_[i].get(), static_cast<uint32_t>(i));
+        }
+
+        // Converting edge lists to offsets and targets
+        if (implicitEdges_)
+            buildBuckets();
+        else {
+            edgeOffsets_.assign(vertexCount + 1, 0);
+            for (size_t i = 0; i < vertexCount; ++i)
+                edgeOffsets_[i + 1] = edgeOffsets_[i] + vertices_[i]->edges().size();
+            edgeTargets_.clear();
+            edgeTargets_.reserve(edgeOffsets_[vertexCount]);
+            for (const auto &vertex: vertices_)
+                for (const auto &edge: vertex->edges())
+                    edgeTargets_.push_back(positions.at(edge.get()));
+        }
+
+        // Equal pieces share one slot, so they are visited only once per combination
+        unordered_map<size_t, uint32_t> keySlots;
+        slots_.resize(vertexCount);
+        slotLimits_.clear();
+        for (size_t i = 0; i < vertexCount; ++i) {
+            auto [slot, inserted] = keySlots.try_emplace(keyGenerator(vertices_[i]),
+                                                         static_cast<uint32_t>(slotLimits_.size()));
+            if (inserted)
+                slotLimits_.push_back(0);
+            slots_[i] = slot->second;
+            slotLimits_[slot->second] = std::max(slotLimits_[slot->second], vertices_[i]->count());
+        }
+
+        pieceCount_ = 0;
+        for (const uint32_t limit: slotLimits_)
+            pieceCount_ += limit;
+
+        sortByEdgeCount();
+        buildComponents();
+        buildClosure();
+        buildProfiles();
+        initState(state_);
+        bestPath_.reserve(pieceCount_);
+    }
+
+    /**
+     * @brief Groups vertices by their first number for implicit edges.
+     *
+     * createGraph connects a vertex to every vertex that starts with its last number, unless both start
+     * with the same number, in the order of vertices_. So the neighbors of a vertex are exactly the bucket
+     * of its last number, or nothing if its first and last numbers are equal, and only O(V) positions are stored.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::buildBuckets() {
+        bucketOffsets_.assign(JunctionClosure::JUNCTIONS + 1, 0);
+        for (const auto &vertex: vertices_)
+            ++bucketOffsets_[static_cast<size_t>(vertex->first()) + 1];
+        for (size_t j = 0; j < JunctionClosure::JUNCTIONS; ++j)
+            bucketOffsets_[j + 1] += bucketOffsets_[j];
+
+        // Counting sort is stable, so every bucket keeps the order of vertices_
+        vector<uint32_t> next(bucketOffsets_.begin(), bucketOffsets_.end() - 1);
+        bucketVertices_.resize(vertices_.size());
+        for (uint32_t v = 0; v < vertices_.size(); ++v)
+            bucketVertices_[next[static_cast<size_t>(vertices_[v]->first())]++] = v;
+    }
+
+    /**
+     * @brief Splits the graph into weakly connected components.
+     *
+     * Components are found with a union-find over edges. Every component keeps its start vertices
+     * in the global start order and the number of its pieces, which bounds the length of any path in it.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::buildComponents() {
+        const size_t vertexCount = vertices_.size();
+
+        // Union-find with path halving
+        vector<uint32_t> parents(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+            parents[i] = static_cast<uint32_t>(i);
+        auto findRoot = [&](uint32_t vertex) {
+            while (parents[vertex] != vertex)
+                vertex = parents[vertex] = parents[parents[vertex]];
+            return vertex;
+        };
+
+        auto unite = [&](const uint32_t first, const uint32_t second) {
+            const uint32_t a = findRoot(first);
+            const uint32_t b = findRoot(second);
+            if (a != b)
+                parents[std::max(a, b)] = std::min(a, b);
+        };
+
+        if (implicitEdges_) {
+            // A vertex with neighbors is connected to its whole bucket, so the bucket is united once,
+            // and the number of operations doesn't depend on the number of edges
+            vector<bool> bucketUnited(JunctionClosure::JUNCTIONS, false);
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                const auto edges = neighbors(v);
+                if (edges.empty())
+                    continue;
+
+                unite(v, edges.front());
+                const auto bucket = static_cast<size_t>(vertices_[v]->last());
+                if (!bucketUnited[bucket]) {
+                    bucketUnited[bucket] = true;
+                    for (const uint32_t e: edges)
+                        unite(edges.front(), e);
+                }
+            }
+        } else
+            for (uint32_t v = 0; v < vertexCount; ++v)
+                for (const uint32_t e: neighbors(v))
+                    unite(v, e);
+
+        // Numbering components in the start order, so starts of every component stay in that order
+        vector<uint32_t> componentOf(vertexCount, NONE);
+        vector<uint32_t> slotComponent(slotLimits_.size(), NONE);
+        components_.clear();
+        for (uint32_t position = 0; position < order_.size(); ++position) {
+            const uint32_t vertex = order_[position];
+            uint32_t &component = componentOf[findRoot(vertex)];
+            if (component == NONE) {
+                component = static_cast<uint32_t>(components_.size());
+                components_.emplace_back();
+            }
+
+            Component &target = components_[component];
+            target.starts.push_back(position);
+            target.edgeCount += neighbors(vertex).size();
+
+            // Identical pieces of one slot are counted once
+            if (slotComponent[slots_[vertex]] != component) {
+                slotComponent[slots_[vertex]] = component;
+                target.pieceCount += slotLimits_[slots_[vertex]];
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the junction closure and the length bounds of the junctions.
+     *
+     * A piece whose numbers at the ends are equal has no edges, so it only ends a path and isn't an arc.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::buildClosure() {
+        // Pieces of every slot by their first number
+        array<size_t, JunctionClosure::JUNCTIONS> startingPieces{};
+        vector<bool> slotCounted(slotLimits_.size(), false);
+
+        closure_ = {};
+        for (const auto &vertex: vertices_)
+            if (vertex->first() != vertex->last())
+                closure_.addArc(static_cast<unsigned>(vertex->first()), static_cast<unsigned>(vertex->last()));
+        for (size_t i = 0; i < vertices_.size(); ++i)
+            if (!slotCounted[slots_[i]]) {
+                slotCounted[slots_[i]] = true;
+                startingPieces[static_cast<size_t>(vertices_[i]->first())] += slotLimits_[slots_[i]];
+            }
+        closure_.close();
+
+        for (unsigned junction = 0; junction < JunctionClosure::JUNCTIONS; ++junction) {
+            JunctionClosure::Row reachable = closure_.reachableFrom(junction);
+            reachable.set(junction);
+
+            junctionBounds_[junction] = 0;
+            for (size_t other = 0; other < JunctionClosure::JUNCTIONS; ++other)
+                if (reachable.test(other))
+                    junctionBounds_[junction] += startingPieces[other];
+        }
+    }
+
+    /**
+     * @brief Gathers the profiles of the components, which choose their engines.
+     *
+     * A component has a cycle if a junction of its pieces reaches itself in the junction closure:
+     * pieces of the cycle end where the next ones start, so they are connected to the component.
+     * Junction balances of every component are summed in one array, only the touched junctions are reset.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::buildProfiles() {
+        array<int64_t, JunctionClosure::JUNCTIONS> balances{};
+        array<uint32_t, JunctionClosure::JUNCTIONS> junctionComponent;
+        junctionComponent.fill(NONE);
+        vector<size_t> touched;
+        vector<uint32_t> slotComponent(slotLimits_.size(), NONE);
+
+        for (uint32_t c = 0; c < components_.size(); ++c) {
+            Component &component = components_[c];
+            bool loops = false;
+            component.acyclic = true;
+            touched.clear();
+
+            for (const uint32_t position: component.starts) {
+                const uint32_t vertex = order_[position];
+                const auto first = static_cast<size_t>(vertices_[vertex]->first());
+                const auto last = static_cast<size_t>(vertices_[vertex]->last());
+                if (first == last) {
+                    loops = true;
+                    continue;
+                }
+                if (closure_.reaches(static_cast<unsigned>(first), static_cast<unsigned>(first)))
+                    component.acyclic = false;
+
+                // Every piece of a slot is one arc of the trail
+                if (slotComponent[slots_[vertex]] == c)
+                    continue;
+                slotComponent[slots_[vertex]] = c;
+                for (const size_t junction: {first, last})
+                    if (junctionComponent[junction] != c) {
+                        junctionComponent[junction] = c;
+                        touched.push_back(junction);
+                    }
+                balances[first] += slotLimits_[slots_[vertex]];
+                balances[last] -= slotLimits_[slots_[vertex]];
+            }
+
+            // A trail starts at the junction with one more piece out and ends at the one with one more piece in
+            size_t starts = 0, ends = 0;
+            bool balanced = true;
+            for (const size_t junction: touched) {
+                if (balances[junction] == 1)
+                    ++starts;
+                else if (balances[junction] == -1)
+                    ++ends;
+                else if (balances[junction] != 0)
+                    balanced = false;
+                balances[junction] = 0;
+            }
+            component.eulerian = !loops && balanced && starts == ends && starts <= 1;
+        }
+    }
+
+    /**
+     * @brief Returns a fingerprint of the graph, the same pieces in the same order give the same fingerprint.
+     *
+     * The fingerprint is FNV-1a of the pieces and their counts in the start order, and of the salt.
+     *
+     * @param salt A value that tells searches of the same graph apart, f.e. the search mode.
+     * @return The fingerprint.
+     */
+    template<typename vType, size_t vCount>
+    uint64_t Graph<vType, vCount>::fingerprint(const uint64_t salt) const {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const uint64_t value) {
+            for (size_t i = 0; i < sizeof(value); ++i) {
+                hash ^= (value >> (i * 8)) & 0xFF;
+                hash *= 1099511628211ull;
+            }
+        };
+
+        mix(order_.size());
+        for (const uint32_t vertex: order_) {
+            mix(keyGenerator(vertices_[vertex]));
+            mix(slotLimits_[slots_[vertex]]);
+        }
+        mix(salt);
+        return hash;
+    }
+
+    /**
+     * @brief Returns an upper bound of the length of any path from a vertex.
+     *
+     * The next piece starts at the last number of the vertex, and every piece after it
+     * at a junction reachable from there, so other pieces can't be in the path.
+     *
+     * @param vertex The position of the vertex.
+     * @return The maximal number of pieces in a path from the vertex.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::lengthBound(const uint32_t vertex) const {
+        const auto &numbers = vertices_[vertex];
+        if (numbers->first() == numbers->last())
+            return 1;
+        return std::min(pieceCount_, 1 + junctionBounds_[static_cast<size_t>(numbers->last())]);
+    }
+
+    /**
+     * @brief Returns the key of a combination, a bigger key is a better combination.
+     *
+     * A longer combination is better, of equally long ones the one with the earlier start.
+     *
+     * @param length The number of pieces in the combination.
+     * @param position The position in the start order of its first vertex.
+     * @return The key.
+     */
+    template<typename vType, size_t vCount>
+    uint64_t Graph<vType, vCount>::searchKey(const size_t length, const size_t position) {
+        return static_cast<uint64_t>(length) << 32 | (NONE - static_cast<uint32_t>(position));
+    }
+
     /**
      * @brief Sorts vertices in the graph by the number of edges they have.
      *
      * This function uses a lambda function as the comparison criterion for the std::sort function.
-     * The vertices are sorted in descending order based on the number of edges they have.
+     * The vertices are sorted in ascending order based on the number of edges they have.
+     * The result is stored as a start order, so vertex positions used by the index stay valid.
+     * It is done once, when the graph is built.
      */
     template<typename vType, size_t vCount>
     void Graph<vType, vCount>::sortByEdgeCount() {
-        function<bool(const shared_ptr<Vertex<vType, vCount> > &, const shared_ptr<Vertex<vType, vCount> > &)>
-                compare = [&](const shared_ptr<Vertex<vType, vCount> > &a,
-                              const shared_ptr<Vertex<vType, vCount> > &b) {
-                    return a->edges().size() < b->edges().size();
+        order_.resize(vertices_.size());
+        for (size_t i = 0; i < order_.size(); ++i)
+            order_[i] = static_cast<uint32_t>(i);
+
+        function<bool(const uint32_t &, const uint32_t &)>
+                compare = [&](const uint32_t &a, const uint32_t &b) {
+                    return neighbors(a).size() < neighbors(b).size();
                 };
-        std::sort(vertices_.begin(), vertices_.end(), compare);
+        std::sort(order_.begin(), order_.end(), compare);
     }
 
     /**
      * @brief Generates a unique key for a given vertex.
      *
-     * This function calculates a unique key based on the first, middle, and last parts of the vertex.
-     * The key is a double value that is obtained by multiplying the first part by 10000,
-     * the middle part by 100, and adding the last part.
+     * This function calculates a unique key from all numbers of the vertex,
+     * treating them as digits of a base 100 number, f.e. [56,12,34] -> 561234.
      *
      * @param vertex The vertex for which the key needs to be generated.
      * @return The unique key for the given vertex.
      */
     template<typename vType, size_t vCount>
-    double Graph<vType, vCount>::keyGenerator(const std::shared_ptr<Vertex<vType, vCount> > &vertex) {
-        return static_cast<double>(vertex->first() * 10000 + vertex->middle() * 100 + vertex->last());
+    size_t Graph<vType, vCount>::keyGenerator(const std::shared_ptr<Vertex<vType, vCount> > &vertex) {
+        return pieceKey(*vertex->vNumbers());
+    }
+
+    /**
+     * @brief Returns the neighbors of a vertex from the index.
+     *
+     * @param vertex The position of the vertex.
+     * @return A view of the positions of neighboring vertices, in edge order.
+     */
+    template<typename vType, size_t vCount>
+    span<const uint32_t> Graph<vType, vCount>::neighbors(const uint32_t vertex) const {
+        if (implicitEdges_) {
+            const auto &numbers = vertices_[vertex];
+            if (numbers->first() == numbers->last())
+                return {};
+
+            const auto bucket = static_cast<size_t>(numbers->last());
+            return {
+                bucketVertices_.data() + bucketOffsets_[bucket], bucketVertices_.data() + bucketOffsets_[bucket + 1]
+            };
+        }
+        return {edgeTargets_.data() + edgeOffsets_[vertex], edgeTargets_.data() + edgeOffsets_[vertex + 1]};
+    }
+
+    /**
+     * @brief Prepares a search state for this graph.
+     *
+     * Every expansion uses one piece, one frame at most and one record,
+     * so the preallocated state never grows during a search.
+     *
+     * @param state The state.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::initState(SearchState &state) const {
+        state.slotStamps.assign(slotLimits_.size(), 0);
+        state.slotUses.assign(slotLimits_.size(), 0);
+        state.epoch = 0;
+        state.frames.reserve(pieceCount_);
+        state.recordVertices.reserve(pieceCount_);
+        state.recordNext.reserve(pieceCount_);
+        state.recordParents.reserve(pieceCount_);
+        state.recordLengths.reserve(pieceCount_);
+        state.localSlots.assign(slotLimits_.size(), NONE);
     }
 
+    /**
+     * @brief Starts a new search, forgetting all visited slots in O(1).
+     *
+     * @param state The state of the search.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::newEpoch(SearchState &state) {
+        // On overflow the stamps are cleared once, so old stamps can't match again
+        if (++state.epoch == 0) {
+            std::fill(state.slotStamps.begin(), state.slotStamps.end(), 0);
+            state.epoch = 1;
+        }
+        state.recordVertices.clear();
+        state.recordNext.clear();
+        state.recordParents.clear();
+        state.recordLengths.clear();
+    }
+
+    /**
+     * @brief Tries to use a vertex in the current search.
+     *
+     * @param state The state of the search.
+     * @param vertex The position of the vertex.
+     * @return True if its slot still has unused pieces (and one is taken now), false otherwise.
+     */
+    template<typename vType, size_t vCount>
+    bool Graph<vType, vCount>::enterVertex(SearchState &state, const uint32_t vertex) const {
+        const uint32_t slot = slots_[vertex];
+
+        if (state.slotStamps[slot] != state.epoch) {
+            state.slotStamps[slot] = state.epoch;
+            state.slotUses[slot] = 1;
+            return true;
+        }
+        if (state.slotUses[slot] < slotLimits_[slot]) {
+            ++state.slotUses[slot];
+            return true;
+        }
+        return false;
+    }
 
     /**
-     * @brief Helper function for depth-first search (DFS) traversal.
+     * @brief Depth-first search (DFS) traversal from one vertex.
      *
-     * This function performs a DFS traversal starting from the given vertex.
-     * It keeps track of visited vertices using a set and constructs the longest path
-     * by recursively visiting neighboring vertices.
+     * Visits vertices in the same order as a recursive DFS would, but keeps the state
+     * of every level in an explicit stack, so the depth of the search is limited only by memory.
+     * Vertices stay visited for the whole search, and each expansion is saved as a record
+     * with its best continuation, so the longest path can be restored afterward.
      *
-     * @param vertex The starting vertex for the DFS traversal.
-     * @param visited A set to keep track of visited vertices.
-     * @return The longest path found from the starting vertex.
+     * @param state The state of the search, newEpoch() must be called before.
+     * @param start The position of the starting vertex.
+     * @param startRecord Receives the record of the starting vertex.
+     * @param stop The token checked every STOP_CHECK_INTERVAL steps, the search returns 0 once a stop is requested.
+     * @return The number of pieces in the longest path found from the starting vertex.
      */
     template<typename vType, size_t vCount>
-    string Graph<vType, vCount>::dfsHelper(const shared_ptr<Vertex<vType, vCount> > &vertex,
-                                           unordered_set<double> &visited) {
-        // Generate a unique key for the current vertex
-        double vertexKey = keyGenerator(vertex);
+    uint32_t Graph<vType, vCount>::dfsFrom(SearchState &state, const uint32_t start, uint32_t &startRecord,
+                                           const stop_token &stop) const {
+        startRecord = NONE;
+        uint32_t steps = 0;
+
+        // The state is preallocated by initState(), so the loop must not allocate
+        allocation::HotPathScope hotPath;
+
+        // The start is rejected only if its piece was already used
+        if (!enterVertex(state, start))
+            return 0;
 
-        // If the vertex is null, return an empty string
-        if (!vertex)
-            return {};
+        auto &frames = state.frames;
+        frames.clear();
+        frames.push_back({start, 0, 0, NONE, 0});
+        state.recordVertices.push_back(start);
+        state.recordNext.push_back(NONE);
+        state.recordParents.push_back(NONE);
+        state.recordLengths.push_back(0);
 
-        // If the vertex has already been visited, return an empty string
-        if (visited.contains(vertexKey))
-            return {};
+        while (true) {
+            // Cooperative cancellation, the check is rare, so it costs nothing in the loop
+            if (++steps == STOP_CHECK_INTERVAL) {
+                steps = 0;
+                if (stop.stop_requested())
+                    return 0;
+            }
+
+            SearchFrame &frame = frames.back();
+            const auto edges = neighbors(frame.vertex);
 
-        // Mark the vertex as visited
-        visited.insert(vertexKey);
+            if (frame.cursor < edges.size()) {
+                const uint32_t neighbor = edges[frame.cursor];
 
-        // If the vertex has no edges, return its puzzle part
-        if (vertex->edges().empty())
-            return vertex->puzzlePart();
+                // Neighbor that can't be used anymore adds nothing, move to the next one
+                if (!enterVertex(state, neighbor)) {
+                    ++frame.cursor;
+                    continue;
+                }
 
-        // Initialize a string to store the maximum path
-        string maxPath;
+                // Descend into the neighbor. The cursor isn't moved, the next try of it will fail
+                // unless its slot allows more uses.
+                const auto record = static_cast<uint32_t>(state.recordVertices.size());
+                state.recordVertices.push_back(neighbor);
+                state.recordNext.push_back(NONE);
+                state.recordParents.push_back(frame.record);
+                state.recordLengths.push_back(0);
+                frames.push_back({neighbor, 0, 0, NONE, record});
+                continue;
+            }
 
-        // Iterate over all neighboring vertices
-        for (const auto &neighbor: vertex->edges()) {
-            // Recursively find the longest path from the neighbor
-            string neighborPath = dfsHelper(neighbor, visited);
+            // All neighbors are checked, the path of this vertex is itself plus the longest child path
+            const uint32_t length = frame.bestLength + 1;
+            const uint32_t record = frame.record;
+            state.recordNext[record] = frame.bestRecord;
+            state.recordLengths[record] = length;
+            frames.pop_back();
+
+            if (frames.empty()) {
+                startRecord = record;
+                return length;
+            }
 
-            // Update the maximum path if the neighbor's path is longer
-            if (neighborPath.length() > maxPath.length())
-                maxPath = std::move(neighborPath);
+            // Update the parent if this path is longer
+            SearchFrame &parent = frames.back();
+            if (length > parent.bestLength) {
+                parent.bestLength = length;
+                parent.bestRecord = record;
+            }
         }
+    }
+
+    /**
+     * @brief Restores the path of vertices from an expansion record.
+     *
+     * @param state The state of the search that made the record.
+     * @param record The record where the path starts.
+     * @param path The vector that receives positions of the vertices.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::collectPath(const SearchState &state, uint32_t record, vector<uint32_t> &path) {
+        path.clear();
+        for (; record != NONE; record = state.recordNext[record])
+            path.push_back(state.recordVertices[record]);
+    }
+
+    /**
+     * @brief Collects the pieces of a component for an engine that solves the whole component.
+     *
+     * Every piece is a unit, identical pieces of one slot are adjacent units. Pieces of one slot have
+     * the same numbers, so they have the same neighbors, and the first vertex of the slot stands for all.
+     * Starts are in the start order, so every unit gets the earliest position of the vertices of its slot.
+     *
+     * @param state The state of the search, its unit buffers are filled.
+     * @param component The component.
+     */
+    template<typename vType, size_t vCount>
+    void Graph<vType, vCount>::collectUnits(SearchState &state, const Component &component) const {
+        // Slots of the previous component are forgotten
+        for (const uint32_t vertex: state.unitVertices)
+            state.localSlots[slots_[vertex]] = NONE;
+        state.slotUnits.clear();
+        state.unitVertices.clear();
+        state.unitPriorities.clear();
 
-        // If no path was found, use the vertex's last puzzle part
-        if (maxPath.empty())
-            maxPath = vertex->puzzlePartLast();
+        for (const uint32_t start: component.starts) {
+            const uint32_t vertex = order_[start];
+            uint32_t &local = state.localSlots[slots_[vertex]];
+            if (local != NONE)
+                continue;
 
-        // Return the concatenated path
-        return vertex->puzzlePart() + maxPath;
+            local = static_cast<uint32_t>(state.slotUnits.size());
+            state.slotUnits.push_back(static_cast<uint32_t>(state.unitVertices.size()));
+            for (uint32_t copy = 0; copy < slotLimits_[slots_[vertex]]; ++copy) {
+                state.unitVertices.push_back(vertex);
+                state.unitPriorities.push_back(start);
+            }
+        }
+        state.slotUnits.push_back(static_cast<uint32_t>(state.unitVertices.size()));
+    }
+
+    /**
+     * @brief Solves a whole component with one of the engines.
+     *
+     * Every engine finds the longest path of the component, of equally long paths it prefers
+     * the earliest start, as far as the engine allows.
+     *
+     * @param solver The engine, it must apply to the component and can't be DFS.
+     * @param state The state of the search.
+     * @param component The component.
+     * @param path The vector that receives positions of the vertices of the path.
+     * @param position Receives the position in the start order of the first vertex of the path.
+     * @return The number of pieces in the path.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::solveComponent(const SolverKind solver, SearchState &state,
+                                                const Component &component, vector<uint32_t> &path,
+                                                size_t &position) const {
+        collectUnits(state, component);
+        switch (solver) {
+            case SolverKind::EXACT:
+                return solveExact(state, path, position);
+            case SolverKind::DAG:
+                return solveAcyclic(state, path, position);
+            default:
+                return solveEuler(state, path, position);
+        }
+    }
+
+    /**
+     * @brief Finds the longest path of a small component exactly.
+     *
+     * Unlike DFS, which keeps vertices visited for the whole search from a start, the exact solver tries
+     * every order of the units, so its path may be longer. Of equally long paths the one with
+     * the earliest start wins, as in DFS.
+     *
+     * @param state The state with the collected units, at most ExactSolver::MAX_PIECES of them.
+     * @param path The vector that receives positions of the vertices of the path.
+     * @param position Receives the position in the start order of the first vertex of the path.
+     * @return The number of pieces in the path.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::solveExact(SearchState &state, vector<uint32_t> &path, size_t &position) const {
+        const auto &slotUnits = state.slotUnits;
+
+        state.exact.reset(state.unitVertices.size());
+        for (size_t from = 0; from + 1 < slotUnits.size(); ++from)
+            for (const uint32_t neighbor: neighbors(state.unitVertices[slotUnits[from]])) {
+                const uint32_t to = state.localSlots[slots_[neighbor]];
+                for (size_t i = slotUnits[from]; i < slotUnits[from + 1]; ++i)
+                    for (size_t j = slotUnits[to]; j < slotUnits[to + 1]; ++j)
+                        state.exact.addArc(i, j);
+            }
+
+        const size_t length = state.exact.solve(state.unitPriorities, state.unitPath);
+        path.clear();
+        for (const uint32_t unit: state.unitPath)
+            path.push_back(state.unitVertices[unit]);
+        position = state.unitPriorities[state.unitPath.front()];
+        return length;
+    }
+
+    /**
+     * @brief Finds the longest path of a component without cycles in topological order.
+     *
+     * Without cycles no slot can appear in a path twice, so slots are vertices of a DAG.
+     * The length of the longest path from every slot is computed from the sinks back, in O(V + E).
+     * Of equally long paths the one with the earliest start wins, the next vertex is the first
+     * neighbor with the longest path.
+     *
+     * @param state The state with the collected units.
+     * @param path The vector that receives positions of the vertices of the path.
+     * @param position Receives the position in the start order of the first vertex of the path.
+     * @return The number of pieces in the path.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::solveAcyclic(SearchState &state, vector<uint32_t> &path, size_t &position) const {
+        const size_t slotCount = state.slotUnits.size() - 1;
+        auto slotVertex = [&](const size_t local) { return state.unitVertices[state.slotUnits[local]]; };
+        auto &order = state.unitOrder;
+        auto &values = state.unitValues;
+
+        // Kahn's algorithm, the values are the numbers of unprocessed arcs into every slot
+        values.assign(slotCount, 0);
+        for (size_t local = 0; local < slotCount; ++local)
+            for (const uint32_t neighbor: neighbors(slotVertex(local)))
+                ++values[state.localSlots[slots_[neighbor]]];
+        order.clear();
+        for (uint32_t local = 0; local < slotCount; ++local)
+            if (values[local] == 0)
+                order.push_back(local);
+        for (size_t i = 0; i < order.size(); ++i)
+            for (const uint32_t neighbor: neighbors(slotVertex(order[i])))
+                if (--values[state.localSlots[slots_[neighbor]]] == 0)
+                    order.push_back(state.localSlots[slots_[neighbor]]);
+
+        // Now the values are the lengths of the longest paths from the slots
+        for (size_t i = order.size(); i-- > 0;) {
+            uint32_t longest = 0;
+            for (const uint32_t neighbor: neighbors(slotVertex(order[i])))
+                longest = std::max(longest, values[state.localSlots[slots_[neighbor]]]);
+            values[order[i]] = longest + 1;
+        }
+
+        // Slots are in the start order, so the first longest one has the earliest start
+        uint32_t local = 0;
+        for (uint32_t other = 1; other < slotCount; ++other)
+            if (values[other] > values[local])
+                local = other;
+
+        const size_t length = values[local];
+        position = state.unitPriorities[state.slotUnits[local]];
+        path.clear();
+        while (true) {
+            path.push_back(slotVertex(local));
+            if (values[local] == 1)
+                break;
+            for (const uint32_t neighbor: neighbors(slotVertex(local)))
+                if (values[state.localSlots[slots_[neighbor]]] + 1 == values[local]) {
+                    local = state.localSlots[slots_[neighbor]];
+                    break;
+                }
+        }
+        return length;
+    }
+
+    /**
+     * @brief Finds a path through all pieces of a component with balanced junctions (Hierholzer's algorithm).
+     *
+     * Pieces are arcs between junctions, so a trail that passes every arc once is a path of all pieces.
+     * It starts at the junction with more pieces out than in, or, for a closed trail, it is rotated
+     * to start with the earliest piece. It takes O(V) time.
+     *
+     * @param state The state with the collected units.
+     * @param path The vector that receives positions of the vertices of the path.
+     * @param position Receives the position in the start order of the first vertex of the path.
+     * @return The number of pieces in the path.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::solveEuler(SearchState &state, vector<uint32_t> &path, size_t &position) const {
+        const auto unitCount = static_cast<uint32_t>(state.unitVertices.size());
+        auto first = [&](const uint32_t unit) {
+            return static_cast<size_t>(vertices_[state.unitVertices[unit]]->first());
+        };
+        auto last = [&](const uint32_t unit) {
+            return static_cast<size_t>(vertices_[state.unitVertices[unit]]->last());
+        };
+
+        // Units grouped by their first junction, in the start order, by a counting sort
+        array<uint32_t, JunctionClosure::JUNCTIONS + 1> offsets{};
+        array<int64_t, JunctionClosure::JUNCTIONS> balances{};
+        for (uint32_t unit = 0; unit < unitCount; ++unit) {
+            ++offsets[first(unit) + 1];
+            ++balances[first(unit)];
+            --balances[last(unit)];
+        }
+        for (size_t j = 0; j < JunctionClosure::JUNCTIONS; ++j)
+            offsets[j + 1] += offsets[j];
+        auto &byJunction = state.unitOrder;
+        byJunction.resize(unitCount);
+        array<uint32_t, JunctionClosure::JUNCTIONS> cursors;
+        std::copy(offsets.begin(), offsets.end() - 1, cursors.begin());
+        for (uint32_t unit = 0; unit < unitCount; ++unit)
+            byJunction[cursors[first(unit)]++] = unit;
+        std::copy(offsets.begin(), offsets.end() - 1, cursors.begin());
+
+        // Unit 0 has the earliest start, an open trail must start where more pieces go out
+        size_t start = first(0);
+        for (size_t j = 0; j < JunctionClosure::JUNCTIONS; ++j)
+            if (balances[j] == 1)
+                start = j;
+
+        // The stack has the units of the current walk, the trail is completed from its end
+        auto &stack = state.unitValues;
+        auto &trail = state.unitPath;
+        stack.clear();
+        trail.clear();
+        stack.push_back(NONE);
+        while (!stack.empty()) {
+            const size_t junction = stack.back() == NONE ? start : last(stack.back());
+            if (cursors[junction] < offsets[junction + 1])
+                stack.push_back(byJunction[cursors[junction]++]);
+            else {
+                if (stack.back() != NONE)
+                    trail.push_back(stack.back());
+                stack.pop_back();
+            }
+        }
+        std::reverse(trail.begin(), trail.end());
+
+        // A closed trail may start with any of its pieces
+        if (last(trail.back()) == first(trail.front()))
+            std::rotate(trail.begin(), std::find(trail.begin(), trail.end(), 0u), trail.end());
+
+        path.clear();
+        for (const uint32_t unit: trail)
+            path.push_back(state.unitVertices[unit]);
+        position = state.unitPriorities[trail.front()];
+        return trail.size();
     }
 
     /**
      * @brief Performs a depth-first search (DFS) on the graph.
      *
-     * This function sorts the vertices by the number of edges and then
-     * iterates over each vertex to find the longest path using DFS.
+     * Components are searched the biggest ones first. The search from every start vertex is independent,
+     * so all threads take the next start of the same component, and one big component uses all of them.
+     * The best combination is shared as one atomic key, so every thread skips a component or a start vertex
+     * as soon as it can't give a better combination: by the number of pieces of the component,
+     * or by the junction closure for a start. Of equally long combinations the one with the earliest
+     * start wins, so the result doesn't depend on the number of threads.
      *
+     * With checkpoints, the progress of every component is written to a file from a separate thread:
+     * the best combination and the starts up to the first one that isn't searched yet.
+     * A resumed search continues every component from there, so it gives the same result.
+     *
+     * Every component is solved by the requested engine if it applies to the component, otherwise by DFS.
+     * In the automatic mode the engine is chosen by the profile of the component. A component solved
+     * by an engine is one task of one thread.
+     *
+     * @param threadCount Number of threads, 0 means the number of hardware threads.
+     * @param checkpoint Settings of checkpoints, they are disabled by default.
+     * @param solver The engine, or SolverKind::AUTO.
      * @return The longest path found in the graph.
      */
     template<typename vType, size_t vCount>
-    string Graph<vType, vCount>::dfs() {
-        // Sort vertices by the number of edges
-        sortByEdgeCount();
+    string Graph<vType, vCount>::dfs(size_t threadCount, const CheckpointSettings &checkpoint,
+                                     const SolverKind solver) {
+        // Components with the most pieces go first, they take the longest and give the best bounds
+        vector<uint32_t> componentOrder(components_.size());
+        for (size_t i = 0; i < componentOrder.size(); ++i)
+            componentOrder[i] = static_cast<uint32_t>(i);
+        std::stable_sort(componentOrder.begin(), componentOrder.end(), [&](const uint32_t a, const uint32_t b) {
+            return components_[a].pieceCount > components_[b].pieceCount;
+        });
 
-        // Initialize a string to store the longest combination
-        string longestCombination;
+        // The best combination: its key (length and position of its start) and its vertices
+        mutex bestMutex;
+        atomic<uint64_t> bestKey = 0;
+        bestPath_.clear();
 
-        // Iterate over all vertices in the graph
-        for (const auto &vertex: vertices_) {
-            // Create a set to track visited vertices for the current vertex
-            unordered_set<double> oneVertexVisited;
+        // Progress of every component, it is updated only when checkpoints are enabled
+        const bool checkpointing = !checkpoint.file.empty();
+        mutex progressMutex;
+        // A checkpoint of another engine has other results of components, so it is rejected
+        const uint64_t searchFingerprint = fingerprint(static_cast<uint64_t>(solver));
+        Checkpoint progress{searchFingerprint, {}};
+        if (checkpointing && checkpoint.resume) {
+            progress = readCheckpoint(checkpoint.file, components_.size(), pieceCount_);
+            if (progress.fingerprint != searchFingerprint)
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_MISMATCH], checkpoint.file);
 
-            // Perform DFS from the current vertex
-            string newCombination = dfsHelper(vertex, oneVertexVisited);
+            // A damaged file may have the right fingerprint, its numbers must still fit the graph
+            for (size_t i = 0; i < components_.size(); ++i) {
+                const ComponentProgress &saved = progress.components[i];
+                const bool fits = saved.nextStart <= components_[i].starts.size() &&
+                                  saved.path.size() == saved.length &&
+                                  (saved.length == 0 || saved.position < order_.size()) &&
+                                  std::all_of(saved.path.begin(), saved.path.end(), [&](const uint32_t vertex) {
+                                      return vertex < vertices_.size();
+                                  });
+                if (!fits)
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[CHECKPOINT_INVALID], checkpoint.file);
+            }
+        } else
+            progress.components.resize(components_.size());
+
+        // Best combinations of the checkpoint are merged at once, as if they were just found
+        for (const ComponentProgress &saved: progress.components)
+            if (saved.length != 0 && searchKey(saved.length, saved.position) > bestKey) {
+                bestKey = searchKey(saved.length, saved.position);
+                bestPath_ = saved.path;
+            }
+
+        // Next start of every component, all threads take starts of the same component
+        vector<atomic<uint32_t> > cursors(components_.size());
+        for (size_t i = 0; i < components_.size(); ++i)
+            cursors[i] = progress.components[i].nextStart;
+
+        // Searched starts by position, only for checkpoints: a component is saved up to its first unsearched start
+        vector<bool> searched(checkpointing ? order_.size() : 0, false);
+        auto markSearched = [&](const Component &component, ComponentProgress &saved, const uint32_t start) {
+            lock_guard lock(progressMutex);
+            searched[component.starts[start]] = true;
+            while (saved.nextStart < component.starts.size() && searched[component.starts[saved.nextStart]])
+                ++saved.nextStart;
+        };
+
+        // A longer combination, or an equally long one with an earlier start, replaces the best one
+        auto offer = [&](ComponentProgress &saved, const size_t length, const size_t position,
+                         const vector<uint32_t> &path) {
+            const uint64_t key = searchKey(length, position);
+            if (key > bestKey) {
+                lock_guard lock(bestMutex);
+                if (key > bestKey) {
+                    bestKey = key;
+                    bestPath_ = path;
+                }
+            }
+            if (checkpointing) {
+                lock_guard lock(progressMutex);
+                if (saved.length == 0 || key > searchKey(saved.length, saved.position)) {
+                    saved.length = length;
+                    saved.position = position;
+                    saved.path = path;
+                }
+            }
+        };
+
+        atomic<size_t> currentComponent = 0;
+
+        auto worker = [&] {
+            SearchState state;
+            initState(state);
+            vector<uint32_t> path;
+
+            while (true) {
+                const size_t i = currentComponent.load();
+                if (i >= componentOrder.size())
+                    return;
+
+                const Component &component = components_[componentOrder[i]];
+                ComponentProgress &saved = progress.components[componentOrder[i]];
+                atomic<uint32_t> &cursor = cursors[componentOrder[i]];
+                const auto startCount = static_cast<uint32_t>(component.starts.size());
+
+                // A component with fewer pieces can't give a longer combination, with as many pieces
+                // it can only win with an earlier start
+                const bool skipped = searchKey(component.pieceCount, component.starts.front()) <= bestKey;
+
+                // A whole-component engine is one task, the thread that takes the first start solves it
+                const SolverKind engine = chooseSolver(solver, component);
+                if (skipped || engine != SolverKind::DFS) {
+                    const uint32_t start = cursor.exchange(startCount);
+                    if (start < startCount && !skipped) {
+                        trace::TraceScope traceEngine(SOLVER_NAMES[static_cast<size_t>(engine)].data(),
+                                                      componentOrder[i]);
+                        size_t position;
+                        const size_t length = solveComponent(engine, state, component, path, position);
+                        offer(saved, length, position, path);
+                    }
+                    if (start < startCount && checkpointing) {
+                        lock_guard lock(progressMutex);
+                        saved.nextStart = startCount;
+                    }
+                    size_t expected = i;
+                    currentComponent.compare_exchange_strong(expected, i + 1);
+                    continue;
+                }
+
+                // Starts are independent, every thread takes the next one, so a big component uses all threads
+                const uint32_t start = cursor++;
+                if (start >= startCount) {
+                    size_t expected = i;
+                    currentComponent.compare_exchange_strong(expected, i + 1);
+                    continue;
+                }
+
+                // The pieces reachable from the start can't make a better combination
+                const uint32_t position = component.starts[start];
+                if (searchKey(lengthBound(order_[position]), position) > bestKey) {
+                    trace::TraceScope traceStart("start", position);
+                    newEpoch(state);
+                    uint32_t startRecord;
+                    const uint32_t length = dfsFrom(state, order_[position], startRecord, {});
+
+                    if (searchKey(length, position) > bestKey) {
+                        collectPath(state, startRecord, path);
+                        offer(saved, length, position, path);
+                    }
+                }
+
+                // Once per start vertex, not per step, so the lock doesn't slow the search
+                if (checkpointing)
+                    markSearched(component, saved, start);
+            }
+        };
 
-            // Update the longest combination if the new combination is longer
-            if (newCombination.size() > longestCombination.size())
-                longestCombination = std::move(newCombination);
+        // Writes a copy of the progress, so workers wait only while it is copied
+        auto saveProgress = [&] {
+            Checkpoint snapshot;
+            {
+                lock_guard lock(progressMutex);
+                snapshot = progress;
+            }
+            writeCheckpoint(checkpoint.file, snapshot);
+        };
+
+        if (threadCount == 0)
+            threadCount = std::max(1u, thread::hardware_concurrency());
+        threadCount = std::min(threadCount, std::max<size_t>(1, order_.size()));
+
+        {
+            jthread writer;
+            if (checkpointing)
+                writer = jthread([&](const stop_token &stop) {
+                    mutex waitMutex;
+                    condition_variable_any wakeUp;
+                    unique_lock lock(waitMutex);
+                    while (true) {
+                        wakeUp.wait_for(lock, stop, checkpoint.interval, [] { return false; });
+                        if (stop.stop_requested())
+                            return;
+                        try {
+                            saveProgress();
+                        } catch (const BracedException &ex) {
+                            // The search goes on, the next checkpoint may succeed
+                            cerr << ex.what() << endl;
+                        }
+                    }
+                });
+
+            if (threadCount == 1)
+                worker();
+            else {
+                vector<jthread> workers;
+                for (size_t i = 0; i < threadCount; ++i)
+                    workers.emplace_back(worker);
+            }
         }
 
+        // The last checkpoint has all components done, resuming from it returns the result at once.
+        // The search is finished, so a failed write is only reported
+        if (checkpointing)
+            try {
+                saveProgress();
+            } catch (const BracedException &ex) {
+                cerr << ex.what() << endl;
+            }
+
         // Return the longest combination found
-        return longestCombination;
+        return combinationToString(bestPath_);
+    }
+
+    /**
+     * @brief Lazily searches the graph, yielding every strictly longer combination as soon as it is found.
+     *
+     * The search is the same as in dfs(), but it runs in one thread over the start order,
+     * and only while the caller asks for the next solution. Start vertices that can't give a longer
+     * combination by the junction closure are skipped.
+     * The caller may stop at any solution by leaving the loop, or request a stop through the token,
+     * which is checked between start vertices and inside DFS, then the sequence ends.
+     *
+     * @param stop The token for cooperative cancellation.
+     * @return A generator of solutions, each one longer than the previous.
+     */
+    template<typename vType, size_t vCount>
+    Generator<Solution> Graph<vType, vCount>::solutions(const stop_token stop) {
+        // Length of the longest combination in pieces
+        uint32_t longestLength = 0;
+        bestPath_.clear();
+
+        // Iterate over all vertices in the graph
+        for (size_t i = 0; i < order_.size(); ++i) {
+            if (stop.stop_requested())
+                co_return;
+
+            if (lengthBound(order_[i]) <= longestLength)
+                continue;
+
+            // Forget vertices visited by the previous start
+            newEpoch(state_);
+
+            // Perform DFS from the current vertex, the event ends before the solution is yielded
+            uint32_t startRecord;
+            uint32_t length;
+            {
+                trace::TraceScope traceStart("start", i);
+                length = dfsFrom(state_, order_[i], startRecord, stop);
+            }
+
+            if (stop.stop_requested())
+                co_return;
+
+            // Report the combination if it is longer than the previous one
+            if (length > longestLength) {
+                longestLength = length;
+                collectPath(state_, startRecord, bestPath_);
+                Solution solution{combinationToString(bestPath_), length, i + 1, order_.size()};
+                co_yield std::move(solution);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the vertices of the longest path found by the last dfs() call.
+     *
+     * @return A const reference to the positions of the vertices in the path.
+     */
+    template<typename vType, size_t vCount>
+    const vector<uint32_t> &Graph<vType, vCount>::bestPath() const {
+        return bestPath_;
+    }
+
+    /**
+     * @brief Extends the best path by closed loops of unused pieces at the junctions it visits.
+     *
+     * It works after any engine: a loop that starts and ends at a junction of the path
+     * may be put into the path at that junction without breaking it. Unused pieces are grouped
+     * by their pair of junctions, so a loop is the shortest cycle of junctions found by BFS over
+     * the pairs that still have pieces, and it is added as many times as all its pairs allow.
+     * Junctions of added loops are visited too, so they are searched for loops as well.
+     * Pairs only lose pieces, so a junction without a loop never gets one, and every junction
+     * is searched until its first failure: the work is linear in the pieces plus a part
+     * bounded by the number of pairs.
+     *
+     * The result keeps the rule of the graph for every engine: a piece that starts and ends at one junction
+     * has no edges out, so it is never followed by another piece. Loops are made of other pieces and put
+     * before a piece of the path, or after its last piece unless it is such a piece. One unused piece
+     * of that kind may only end the path, at its last junction.
+     *
+     * @return The number of added pieces.
+     */
+    template<typename vType, size_t vCount>
+    size_t Graph<vType, vCount>::spliceCycles() {
+        if (bestPath_.empty())
+            return 0;
+
+        constexpr size_t JUNCTIONS = JunctionClosure::JUNCTIONS;
+        auto first = [&](const uint32_t vertex) { return static_cast<size_t>(vertices_[vertex]->first()); };
+        auto last = [&](const uint32_t vertex) { return static_cast<size_t>(vertices_[vertex]->last()); };
+
+        // Copies of every slot that the path leaves, one vertex of the slot stands for all of them
+        vector<uint32_t> unused(slotLimits_);
+        for (const uint32_t vertex: bestPath_)
+            --unused[slots_[vertex]];
+        vector<uint32_t> slotVertices(slotLimits_.size(), NONE);
+        for (uint32_t vertex = 0; vertex < vertices_.size(); ++vertex)
+            if (slotVertices[slots_[vertex]] == NONE)
+                slotVertices[slots_[vertex]] = vertex;
+
+        // Unused pieces grouped by their pair of junctions, by a counting sort
+        vector<uint32_t> offsets(JUNCTIONS * JUNCTIONS + 1, 0);
+        for (size_t slot = 0; slot < slotVertices.size(); ++slot)
+            if (slotVertices[slot] != NONE)
+                offsets[first(slotVertices[slot]) * JUNCTIONS + last(slotVertices[slot]) + 1] += unused[slot];
+        for (size_t pair = 0; pair < JUNCTIONS * JUNCTIONS; ++pair)
+            offsets[pair + 1] += offsets[pair];
+        vector<uint32_t> byPair(offsets.back());
+        vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+        for (size_t slot = 0; slot < slotVertices.size(); ++slot)
+            if (slotVertices[slot] != NONE)
+                for (uint32_t copy = 0; copy < unused[slot]; ++copy) {
+                    const uint32_t vertex = slotVertices[slot];
+                    byPair[cursors[first(vertex) * JUNCTIONS + last(vertex)]++] = vertex;
+                }
+        std::copy(offsets.begin(), offsets.end() - 1, cursors.begin());
+
+        // Junctions that still have unused pieces to every other junction
+        array<JunctionClosure::Row, JUNCTIONS> arcs{};
+        for (size_t from = 0; from < JUNCTIONS; ++from)
+            for (size_t to = 0; to < JUNCTIONS; ++to)
+                if (from != to && offsets[from * JUNCTIONS + to] != offsets[from * JUNCTIONS + to + 1])
+                    arcs[from].set(to);
+
+        // Shortest cycle of junctions through a junction, the loop is written from the junction back to it
+        array<uint8_t, JUNCTIONS> parents{};
+        array<uint8_t, JUNCTIONS> queue{};
+        vector<uint8_t> loop;
+        auto findLoop = [&](const size_t junction) {
+            loop.clear();
+            JunctionClosure::Row seen;
+            seen.set(junction);
+            size_t head = 0, tail = 0;
+            queue[tail++] = static_cast<uint8_t>(junction);
+            while (head < tail) {
+                const size_t from = queue[head++];
+                for (size_t to = 0; to < JUNCTIONS; ++to) {
+                    if (!arcs[from].test(to) || seen.test(to))
+                        continue;
+                    seen.set(to);
+                    parents[to] = static_cast<uint8_t>(from);
+                    if (arcs[to].test(junction)) {
+                        for (size_t j = to; j != junction; j = parents[j])
+                            loop.push_back(static_cast<uint8_t>(j));
+                        loop.push_back(static_cast<uint8_t>(junction));
+                        std::reverse(loop.begin(), loop.end());
+                        return true;
+                    }
+                    queue[tail++] = static_cast<uint8_t>(to);
+                }
+            }
+            return false;
+        };
+
+        // Junctions of the path where a loop may go in, every one of them is searched for loops once
+        const bool openEnd = first(bestPath_.back()) != last(bestPath_.back());
+        JunctionClosure::Row visited;
+        vector<uint8_t> pending;
+        auto visit = [&](const size_t junction) {
+            if (!visited.test(junction)) {
+                visited.set(junction);
+                pending.push_back(static_cast<uint8_t>(junction));
+            }
+        };
+        for (const uint32_t vertex: bestPath_)
+            visit(first(vertex));
+        if (openEnd)
+            visit(last(bestPath_.back()));
+
+        // Loops added at every junction, one after another, so together they are a loop too
+        vector<vector<uint32_t> > loops(JUNCTIONS);
+        size_t added = 0;
+        while (!pending.empty()) {
+            const size_t junction = pending.back();
+            pending.pop_back();
+            while (findLoop(junction)) {
+                // The pair with the fewest pieces limits the number of copies of the loop
+                auto pairOf = [&](const size_t i) { return loop[i] * JUNCTIONS + loop[(i + 1) % loop.size()]; };
+                uint32_t copies = UINT32_MAX;
+                for (size_t i = 0; i < loop.size(); ++i)
+                    copies = std::min(copies, offsets[pairOf(i) + 1] - cursors[pairOf(i)]);
+
+                for (uint32_t copy = 0; copy < copies; ++copy)
+                    for (size_t i = 0; i < loop.size(); ++i)
+                        loops[junction].push_back(byPair[cursors[pairOf(i)]++]);
+                for (size_t i = 0; i < loop.size(); ++i) {
+                    if (cursors[pairOf(i)] == offsets[pairOf(i) + 1])
+                        arcs[loop[i]].reset(loop[(i + 1) % loop.size()]);
+                    visit(loop[i]);
+                }
+                added += static_cast<size_t>(copies) * loop.size();
+            }
+        }
+
+        // Loops end where they start, so the last junction stays the same
+        const size_t end = last(bestPath_.back()) * (JUNCTIONS + 1);
+        const bool closingPiece = openEnd && cursors[end] != offsets[end + 1];
+        if (added == 0 && !closingPiece)
+            return 0;
+
+        // The loops of a junction go in where the path reaches it first, their own junctions are reached in them
+        vector<uint32_t> path;
+        path.reserve(bestPath_.size() + added + 1);
+        JunctionClosure::Row spliced;
+        auto reach = [&](auto &self, const size_t junction) -> void {
+            if (spliced.test(junction))
+                return;
+            spliced.set(junction);
+            for (const uint32_t vertex: loops[junction]) {
+                path.push_back(vertex);
+                self(self, last(vertex));
+            }
+        };
+        for (const uint32_t vertex: bestPath_) {
+            reach(reach, first(vertex));
+            path.push_back(vertex);
+        }
+        if (openEnd)
+            reach(reach, last(bestPath_.back()));
+        if (closingPiece) {
+            path.push_back(byPair[cursors[end]++]);
+            ++added;
+        }
+        bestPath_ = std::move(path);
+        return added;
+    }
+
+    /**
+     * @brief Converts a path of vertices to a puzzle combination.
+     *
+     * Every piece contributes its numbers except the last one, which is shared with the next piece,
+     * the last piece of the path contributes all of its numbers.
+     *
+     * @param path Positions of the vertices in the path.
+     * @return The puzzle combination, or an empty string for an empty path.
+     */
+    template<typename vType, size_t vCount>
+    string Graph<vType, vCount>::combinationToString(const vector<uint32_t> &path) const {
+        string combination;
+        if (path.empty())
+            return combination;
+
+        combination.reserve(path.size() * (vCount - 1) * 2 + 2);
+        for (size_t i = 0; i < path.size(); ++i) {
+            const auto &numbers = *vertices_[path[i]]->vNumbers();
+            const size_t count = i + 1 == path.size() ? vCount : vCount - 1;
+            for (size_t j = 0; j < count; ++j) {
+                combination += static_cast<char>('0' + numbers[j] / 10);
+                combination += static_cast<char>('0' + numbers[j] % 10);
+            }
+        }
+        return combination;
     }
 
     /**
@@ -132,17 +1256,62 @@ namespace graph {
      * It also checks for any missing edges and adds them if necessary.
      *
      * @param vData The map of vertex data used to create the graph.
+     * @param implicitEdges Don't add edges to the vertices, neighbors are found in junction buckets.
      * @return The created graph.
      */
     template<typename vType, size_t vCount>
     Graph<vType, vCount> Graph<vType, vCount>::createGraph(
-        const map<vType, vector<VertexNumbers<vType, vCount> > > &vData) {
+        const map<vType, vector<VertexNumbers<vType, vCount> > > &vData, const bool implicitEdges) {
+        return buildGraph(vData, nullptr, implicitEdges);
+    }
+
+    /**
+     * @brief Creates a graph from a given map of collapsed vertex data.
+     *
+     * Every piece of vData stands for all of its identical copies, their number is taken from counts.
+     * The copies are interchangeable, so DFS may use the piece as many times as it was read.
+     *
+     * @param vData The map of distinct vertex data used to create the graph.
+     * @param counts The table with the number of copies of every piece.
+     * @param implicitEdges Don't add edges to the vertices, neighbors are found in junction buckets.
+     * @return The created graph.
+     */
+    template<typename vType, size_t vCount>
+    Graph<vType, vCount> Graph<vType, vCount>::createGraph(
+        const map<vType, vector<VertexNumbers<vType, vCount> > > &vData,
+        const PieceTable<vType, vCount> &counts, const bool implicitEdges) {
+        return buildGraph(vData, &counts, implicitEdges);
+    }
+
+    /**
+     * @brief Creates vertices and edges of a graph.
+     *
+     * @param vData The map of vertex data used to create the graph.
+     * @param counts The table with the number of copies of every piece, or nullptr if every piece is single.
+     * @param implicitEdges Don't add edges to the vertices, neighbors are found in junction buckets.
+     * @return The created graph.
+     */
+    template<typename vType, size_t vCount>
+    Graph<vType, vCount> Graph<vType, vCount>::buildGraph(
+        const map<vType, vector<VertexNumbers<vType, vCount> > > &vData,
+        const PieceTable<vType, vCount> *counts, const bool implicitEdges) {
+        trace::TraceScope traceBuild("createGraph");
         // Map to save vertices for quick access by key
         map<vType, list<shared_ptr<Vertex<vType, vCount> > > > vertexMap;
         // Filling the vertexMap with lists of Vertices(Vertex class)
         for (const auto &[key, vDataList]: vData)
             for (const auto &vDataListElement: vDataList)
-                vertexMap[key].push_back(make_shared<Vertex<vType, vCount> >(vDataListElement));
+                vertexMap[key].push_back(make_shared<Vertex<vType, vCount> >(
+                    vDataListElement, counts ? counts->count(*vDataListElement) : 1));
+        // Implicit edges are found by the index, vertices keep only their numbers
+        if (implicitEdges) {
+            vector<shared_ptr<Vertex<vType, vCount> > > graph;
+            for (const auto &[key, vertex]: vertexMap)
+                for (const auto &vertexElement: vertex)
+                    graph.push_back(vertexElement);
+
+            return Graph(graph, true);
+        }
         // Adding edges that don't have any neighbors
         auto vertexIterator(vertexMap.begin());
         for (; vertexIterator->first < 0; ++vertexIterator) {
@@ -178,59 +1347,53 @@ namespace graph {
      */
     template<typename vType, size_t vCount>
     void Graph<vType, vCount>::puzzleCombinationIsValid(const string &combination) const {
+        // Pieces are views of the combination, so nothing is copied
+        const string_view view(combination);
         size_t i = 0;
 
         // Check all connected vertices
         for (; i < combination.length() - 4; i += 4) {
-            if (findVertex(combination.substr(i, 6)) == -1)
+            if (findVertex(view.substr(i, 6)) == -1)
                 throw exceptionInFunction(
                     __FUNCTION__,
-                    ERROR_MESSAGES[PUZZLE_INVALID], combination.substr(i, 6), i, i + 6);
+                    ERROR_MESSAGES[PUZZLE_INVALID], view.substr(i, 6), i, i + 6);
         }
         i = combination.length() - 6;
         // Check the last vertex
-        if (findVertex(combination.substr(i, 6)) == -1)
+        if (findVertex(view.substr(i, 6)) == -1)
             throw exceptionInFunction(
                 __FUNCTION__,
-                ERROR_MESSAGES[PUZZLE_INVALID], combination.substr(i, 6), i, i + 6);
-    }
-
-    /**
-     * @brief Converts a graph to a string representation.
-     *
-     * This function converts a graph to a string representation,
-     * displaying the vertices and their edges in a readable format.
-     *
-     * @param vertex The graph to be converted to a string.
-     * @return The string representation of the graph.
-     */
-    template<typename T, size_t C>
-    string to_string(const Graph<T, C> &vertex) {
-        string result;
-        for (auto &v: vertex.vertices_) {
-            result += "[" + graph::to_string(*v) + "]:\n";
-            for (auto &e: v->edges()) {
-                result += "  ->" + to_string(*e) + "\n";
-            }
-        }
-        return result;
+                ERROR_MESSAGES[PUZZLE_INVALID], view.substr(i, 6), i, i + 6);
     }
 
     /**
      * @brief Finds a vertex in the graph based on its string representation.
      *
      * This function searches for a vertex in the graph based on its string representation.
-     * It iterates over all vertices in the graph and compares their string representations.
+     * The representation is parsed to numbers once, and they are compared with the numbers of all vertices,
+     * so no strings are made.
      *
-     * @param vertex The string representation of the vertex to be found.
+     * @param vertex The string representation of the vertex to be found, two digits per number.
      * @return The index of the vertex in the graph if found, or -1 if not found.
      */
     template<typename vType, size_t vCount>
-    signed long long Graph<vType, vCount>::findVertex(const string &vertex) const {
+    signed long long Graph<vType, vCount>::findVertex(const string_view vertex) const {
+        if (vertex.length() != vCount * 2)
+            return -1;
+
+        array<vType, vCount> numbers;
+        for (size_t j = 0; j < vCount; ++j) {
+            const char high = vertex[j * 2];
+            const char low = vertex[j * 2 + 1];
+            if (!isdigit(static_cast<unsigned char>(high)) || !isdigit(static_cast<unsigned char>(low)))
+                return -1;
+            numbers[j] = static_cast<vType>((high - '0') * 10 + (low - '0'));
+        }
+
         signed long long index = 0;
 
         for (; index < vertices_.size(); ++index)
-            if (!to_string(*(vertices_[index])).compare(vertex))
+            if (*vertices_[index]->vNumbers() == numbers)
                 return index;
         return -1;
     }
@@ -0,0 +1,54 @@
+/**
+ * @file JunctionClosure.cpp
+ * @brief This file contains the implementation of the JunctionClosure class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "JunctionClosure.hpp"
+
+namespace graph {
+    /**
+     * @brief Adds an arc between two junctions, close() must be called after all arcs are added.
+     *
+     * @param from The first number of a piece.
+     * @param to The last number of the piece.
+     */
+    void JunctionClosure::addArc(const unsigned from, const unsigned to) {
+        rows_[from].set(to);
+    }
+
+    /**
+     * @brief Computes the transitive closure of the arcs (Warshall's algorithm).
+     *
+     * If a junction reaches k, it reaches everything k reaches, so the row of k is merged
+     * into it with one bitwise OR.
+     */
+    void JunctionClosure::close() {
+        for (size_t k = 0; k < JUNCTIONS; ++k)
+            for (Row &row: rows_)
+                if (row.test(k))
+                    row |= rows_[k];
+    }
+
+    /**
+     * @brief Checks if one junction reaches another through one or more arcs.
+     *
+     * @param from The first junction.
+     * @param to The second junction.
+     * @return True if there is a chain of arcs from the first junction to the second one.
+     */
+    bool JunctionClosure::reaches(const unsigned from, const unsigned to) const {
+        return rows_[from].test(to);
+    }
+
+    /**
+     * @brief Returns all junctions reachable from a junction through one or more arcs.
+     *
+     * @param junction The junction.
+     * @return The set of reachable junctions.
+     */
+    const JunctionClosure::Row &JunctionClosure::reachableFrom(const unsigned junction) const {
+        return rows_[junction];
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file JunctionClosure.hpp
+ * @brief This file contains the declaration of the JunctionClosure class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef JUNCTION_CLOSURE_HPP
+#define JUNCTION_CLOSURE_HPP
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+namespace graph {
+    using namespace std;
+
+    /**
+     * @brief Transitive closure of the reachability between junctions (two-digit numbers).
+     *
+     * Every piece that can be followed by another one is an arc from its first to its last number.
+     * Rows of the matrix are bitsets, so the closure is computed with whole machine words at once.
+     */
+    class JunctionClosure {
+    public:
+        /**
+         * @brief Number of junctions.
+         */
+        static constexpr size_t JUNCTIONS = 100;
+
+        /**
+         * @brief Set of junctions.
+         */
+        using Row = bitset<JUNCTIONS>;
+
+        void addArc(unsigned from, unsigned to);
+
+        void close();
+
+        bool reaches(unsigned from, unsigned to) const;
+
+        const Row &reachableFrom(unsigned junction) const;
+
+    private:
+        /**
+         * @brief Junctions reachable from every junction through one or more arcs.
+         */
+        array<Row, JUNCTIONS> rows_{};
+    };
+}
+
+#endif // JUNCTION_CLOSURE_HPP
@@ -0,0 +1,66 @@
+/**
+ * @file Solver.cpp
+ * @brief This file contains the implementation of the registry of search engines.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "Solver.hpp"
+#include "ExactSolver.hpp"
+
+namespace graph {
+    /**
+     * @brief Finds an engine by its name.
+     *
+     * @param name The name, one of SOLVER_NAMES.
+     * @return The engine, or nothing if the name is unknown.
+     */
+    optional<SolverKind> solverByName(const string_view name) {
+        for (size_t i = 0; i < SOLVER_NAMES.size(); ++i)
+            if (SOLVER_NAMES[i] == name)
+                return static_cast<SolverKind>(i);
+        return nullopt;
+    }
+
+    /**
+     * @brief Checks whether an engine can solve a component.
+     *
+     * @param solver The engine.
+     * @param profile The profile of the component.
+     * @return True if the engine gives the longest path of the component, DFS always applies.
+     */
+    bool solverApplies(const SolverKind solver, const ComponentProfile &profile) {
+        switch (solver) {
+            case SolverKind::EXACT:
+                return profile.pieceCount <= ExactSolver::MAX_PIECES;
+            case SolverKind::DAG:
+                return profile.acyclic;
+            case SolverKind::EULER:
+                return profile.eulerian;
+            default:
+                return solver == SolverKind::DFS;
+        }
+    }
+
+    /**
+     * @brief Chooses the engine for a component.
+     *
+     * A requested engine that can't solve the component is replaced by DFS.
+     * In the automatic mode the cheapest exact engine wins: an Euler trail takes linear time
+     * and uses all pieces, a topological order takes linear time, and sets of pieces take 2^n words.
+     * DFS is left for big components with cycles.
+     *
+     * @param requested The engine requested by the user, or SolverKind::AUTO.
+     * @param profile The profile of the component.
+     * @return The engine that solves the component.
+     */
+    SolverKind chooseSolver(const SolverKind requested, const ComponentProfile &profile) {
+        if (requested != SolverKind::AUTO)
+            return solverApplies(requested, profile) ? requested : SolverKind::DFS;
+
+        for (const SolverKind solver: {SolverKind::EULER, SolverKind::DAG, SolverKind::EXACT})
+            if (solverApplies(solver, profile))
+                return solver;
+        return SolverKind::DFS;
+    }
+}
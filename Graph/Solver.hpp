@@ -0,0 +1,55 @@
+/**
+ * @file Solver.hpp
+ * @brief This file contains the registry of search engines and the choice of an engine for a component.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace graph {
+    using namespace std;
+
+    /**
+     * @brief Engines that find the longest path of a component.
+     */
+    enum class SolverKind : uint8_t {
+        DFS, ///< DFS from every start vertex, vertices stay visited for the whole search from a start.
+        EXACT, ///< Dynamic programming over sets of used pieces, for small components.
+        DAG, ///< Longest path in topological order, for components without cycles.
+        EULER, ///< Euler trail through all pieces, for components with balanced junctions.
+        AUTO ///< Not an engine: the engine is chosen for every component from its profile.
+    };
+
+    /**
+     * @brief Names of the engines for `--solver`, in the order of SolverKind.
+     */
+    inline constexpr array<string_view, 5> SOLVER_NAMES = {"dfs", "exact", "dag", "euler", "auto"};
+
+    /**
+     * @brief Statistics of a component, gathered when the graph is built.
+     */
+    struct ComponentProfile {
+        size_t pieceCount = 0; ///< Number of pieces, an upper bound of the length of any path.
+        size_t edgeCount = 0; ///< Number of edges.
+        bool acyclic = false; ///< No path comes back to a piece it has passed.
+        bool eulerian = false; ///< One trail can pass all pieces: no piece starts and ends at one junction,
+        ///< and every junction has as many pieces in as out, except the two ends of the trail.
+    };
+
+    optional<SolverKind> solverByName(string_view name);
+
+    bool solverApplies(SolverKind solver, const ComponentProfile &profile);
+
+    SolverKind chooseSolver(SolverKind requested, const ComponentProfile &profile);
+}
+
+#endif // SOLVER_HPP
@@ -0,0 +1,155 @@
+/**
+ * @file Options.cpp
+ * @brief This file contains the implementation of command-line options parsing.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "Options.hpp"
+#include "../Graph/Solver.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace options {
+    /**
+     * @brief The longest time between two checkpoints in seconds, a longer one overflows the nanoseconds of the clock.
+     */
+    constexpr size_t MAX_CHECKPOINT_INTERVAL = 1'000'000'000;
+
+    /**
+     * @brief Function to take the value of an option from the next argument.
+     *
+     * If there is no next argument, it throws a BracedException with a specific error message.
+     *
+     * @param argc Number of arguments.
+     * @param argv Arguments.
+     * @param index Index of the option, moved to its value.
+     * @return The value of the option.
+     */
+    static string optionValue(const int argc, char *argv[], int &index) {
+        if (index + 1 >= argc)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[OPTION_WITHOUT_VALUE], argv[index]);
+        return argv[++index];
+    }
+
+    /**
+     * @brief Function to convert the value of an option to a number.
+     *
+     * If the value isn't a number or doesn't fit, it throws a BracedException with a specific error message.
+     *
+     * @param option The option.
+     * @param value The value of the option.
+     * @return The number.
+     */
+    static size_t numberValue(const string &option, const string &value) {
+        if (value.empty() || !all_of(value.begin(), value.end(), ::isdigit))
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], option, value);
+        try {
+            return stoul(value);
+        } catch (const out_of_range &) {
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], option, value);
+        }
+    }
+
+    /**
+     * @brief Function to parse command-line arguments.
+     *
+     * The first positional argument is the input file and the second one may be `s` to show the graph,
+     * as before. Options that start with `--` may be placed anywhere.
+     * If an argument is unknown, it throws a BracedException with a specific error message.
+     *
+     * @param argc Number of arguments.
+     * @param argv Arguments.
+     * @return Parsed options.
+     */
+    Options parseOptions(const int argc, char *argv[]) {
+        Options result;
+        size_t positional = 0;
+        bool threadsGiven = false;
+
+        for (int i = 1; i < argc; ++i) {
+            const string argument(argv[i]);
+
+            if (argument == "--collapse")
+                result.collapse = true;
+            else if (argument == "--stream")
+                result.stream = true;
+            else if (argument == "--follow")
+                result.follow = result.stream = true;
+            else if (argument == "--implicit")
+                result.implicitEdges = true;
+            else if (argument == "--threads") {
+                result.threads = numberValue(argument, optionValue(argc, argv, i));
+                threadsGiven = true;
+            } else if (argument == "--solver") {
+                result.solver = optionValue(argc, argv, i);
+                if (!graph::solverByName(result.solver))
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], argument, result.solver);
+            } else if (argument == "--splice")
+                result.splice = true;
+            else if (argument == "--progress")
+                result.progress = true;
+            else if (argument == "--export") {
+                result.exportFormat = optionValue(argc, argv, i);
+                if (result.exportFormat != "dot" && result.exportFormat != "json")
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], argument,
+                                              result.exportFormat);
+            } else if (argument == "--export-file")
+                result.exportFile = optionValue(argc, argv, i);
+            else if (argument == "--files")
+                result.fileList = optionValue(argc, argv, i);
+            else if (argument == "--convert")
+                result.convertFile = optionValue(argc, argv, i);
+            else if (argument == "--summarize")
+                result.summaryFile = optionValue(argc, argv, i);
+            else if (argument == "--merge") {
+                result.mergeList = optionValue(argc, argv, i);
+                result.stream = true;
+            } else if (argument == "--checkpoint")
+                result.checkpointFile = optionValue(argc, argv, i);
+            else if (argument == "--resume")
+                result.resume = true;
+            else if (argument == "--checkpoint-interval") {
+                const string value = optionValue(argc, argv, i);
+                result.checkpointInterval = numberValue(argument, value);
+                if (result.checkpointInterval == 0 || result.checkpointInterval > MAX_CHECKPOINT_INTERVAL)
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], argument, value);
+            } else if (argument == "--query")
+                result.queryFile = optionValue(argc, argv, i);
+            else if (argument == "--trace")
+                result.traceFile = optionValue(argc, argv, i);
+            else if (argument == "--allocations")
+                result.allocations = true;
+            else if (argument == "--check-allocations")
+                result.checkAllocations = true;
+            else if (argument.starts_with("--"))
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[UNKNOWN_OPTION], argument);
+            else if (positional == 0) {
+                result.inputFile = argument;
+                ++positional;
+            } else if (positional == 1 && argument == "s") {
+                result.showGraph = true;
+                ++positional;
+            } else
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[UNKNOWN_OPTION], argument);
+        }
+        // Solutions are found by DFS in one thread, without other engines and checkpoints
+        if (result.progress)
+            for (const auto &[given, option]: {
+                     pair{threadsGiven, "--threads"}, pair{result.solver != "dfs", "--solver"},
+                     pair{!result.checkpointFile.empty(), "--checkpoint"}, pair{result.resume, "--resume"}
+                 })
+                if (given)
+                    throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_OPTION_VALUE], "--progress", option);
+        if (!result.exportFormat.empty() && result.exportFile.empty())
+            result.exportFile = "graph." + result.exportFormat;
+        // A summary is made from the table of the streamed input
+        if (!result.summaryFile.empty())
+            result.stream = true;
+        if (result.resume && result.checkpointFile.empty())
+            result.checkpointFile = "search.checkpoint";
+        return result;
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file Options.hpp
+ * @brief This file contains the declaration of command-line options of the application.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <string>
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+
+/**
+ * @brief Namespace for command-line options.
+ */
+namespace options {
+    using namespace std;
+
+    ERRORS_
+    BR_EXCEPT_
+
+    /**
+     * @brief Options of one run of the application.
+     */
+    struct Options {
+        string inputFile = "source.txt"; ///< File with pieces.
+        bool showGraph = false; ///< Print the graph after creation (`s`).
+        bool collapse = false; ///< Collapse identical pieces into one vertex with a count (`--collapse`).
+        bool stream = false; ///< Fold the file into a table of piece counts while reading (`--stream`).
+        bool follow = false; ///< Keep reading pieces appended to the input file (`--follow`).
+        bool implicitEdges = false; ///< Find neighbors in junction buckets instead of edge lists (`--implicit`).
+        size_t threads = 0; ///< Number of search threads, 0 means all hardware threads (`--threads <n>`).
+        string solver = "dfs"; ///< Engine of the search, a name of graph::SOLVER_NAMES (`--solver <name>`).
+        bool splice = false; ///< Splice loops of unused pieces into the found combination (`--splice`).
+        bool progress = false; ///< Print every longer combination as soon as it is found (`--progress`).
+        string exportFormat; ///< Export format of the graph, `dot` or `json` (`--export <format>`).
+        string exportFile; ///< File for the export, `graph.<format>` by default (`--export-file <file>`).
+        string fileList; ///< File with names of input files, one per line (`--files <list>`).
+        string convertFile; ///< Write the input to this file in the binary format and stop (`--convert <file>`).
+        string summaryFile; ///< Write a summary of the input to this file and stop (`--summarize <file>`).
+        string mergeList; ///< File with names of summaries, which are merged and solved (`--merge <list>`).
+        string checkpointFile; ///< File for checkpoints of the search (`--checkpoint <file>`).
+        bool resume = false; ///< Continue the search from the checkpoint (`--resume`).
+        size_t checkpointInterval = 60; ///< Seconds between two checkpoints (`--checkpoint-interval <seconds>`).
+        bool allocations = false; ///< Count allocations and print them for every stage (`--allocations`).
+        bool checkAllocations = false; ///< Fail if the inner loop of the search allocates (`--check-allocations`).
+        string traceFile; ///< Write a timeline of stages and work units in the Chrome trace format (`--trace <file>`).
+        string queryFile; ///< File with queries, one per line, answered instead of the search (`--query <file>`).
+    };
+
+    Options parseOptions(int argc, char *argv[]);
+}
+
+/**
+ * @brief Macro to simplify the use of the options namespace.
+ */
+#define OPTIONS_ using namespace options;
+
+#endif // OPTIONS_HPP
@@ -0,0 +1,93 @@
+/**
+ * @file PieceTable.hpp
+ * @brief This file contains the declaration of the PieceTable class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef PIECE_TABLE_HPP
+#define PIECE_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include "../FileReader/ReaderFunctions.hpp"
+#include "../FileReader/FileFollower.hpp"
+
+namespace reader {
+    /**
+     * @brief Counts of distinct pieces.
+     *
+     * The table has one counter for every possible piece, so its size depends only on the piece geometry
+     * (10^6 counters for pieces of 3 two-digit numbers), not on the number of pieces added.
+     * It also remembers the order in which distinct pieces were seen first.
+     *
+     * @tparam vType The type of the numbers in a piece.
+     * @tparam vCount The number of numbers in a piece.
+     */
+    template<typename vType, size_t vCount>
+    class PieceTable {
+    public:
+        /**
+         * @brief The number of all possible pieces.
+         */
+        static constexpr size_t CAPACITY = pieceKeyCount(vCount);
+
+        PieceTable()
+            : counts_(CAPACITY, 0) {
+        }
+
+    private:
+        /**
+         * @brief Signature and version of the summary format.
+         */
+        static constexpr char SUMMARY_MAGIC[8] = {'B', 'A', 'D', 'S', 'U', 'M', 'M', '1'};
+
+        /**
+         * @brief Number of copies of every piece, indexed by piece key.
+         */
+        vector<uint32_t> counts_;
+
+        /**
+         * @brief Keys of distinct pieces in the order of the first appearance.
+         */
+        vector<uint32_t> order_;
+
+        /**
+         * @brief Number of all pieces added.
+         */
+        size_t total_ = 0;
+
+    public:
+        void add(const array<vType, vCount> &piece, uint32_t count = 1);
+
+        uint32_t count(const array<vType, vCount> &piece) const;
+
+        size_t distinct() const;
+
+        size_t total() const;
+
+        VertexList<vType, vCount> toList() const;
+
+        void sortOrder(size_t first, const vector<uint64_t> &ranks);
+
+        void writeSummary(const string &fileName) const;
+
+        void mergeSummary(const string &fileName);
+    };
+
+    template<typename vType, size_t vCount, size_t stringSize>
+    void readFileToTable(const string &fileName, PieceTable<vType, vCount> &counts);
+
+    template<typename vType, size_t vCount, size_t stringSize>
+    void readFilesToTable(const vector<string> &fileNames, PieceTable<vType, vCount> &counts);
+
+    template<typename vType, size_t vCount, size_t stringSize>
+    size_t followFileToTable(FileFollower &follower, PieceTable<vType, vCount> &counts);
+
+    template<typename vType, size_t vCount>
+    VertexList<vType, vCount> collapseDuplicates(const VertexList<vType, vCount> &lines,
+                                                 PieceTable<vType, vCount> &counts);
+}
+
+#endif // PIECE_TABLE_HPP
+#include "PieceTable.inl"
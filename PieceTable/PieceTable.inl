@@ -0,0 +1,315 @@
+/**
+ * @file PieceTable.inl
+ * @brief This file contains the implementation of the PieceTable class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef PIECE_TABLE_INL
+#define PIECE_TABLE_INL
+
+namespace reader {
+    /**
+     * @brief Adds copies of a piece to the table.
+     *
+     * @param piece The piece to be added.
+     * @param count The number of copies.
+     */
+    template<typename vType, size_t vCount>
+    void PieceTable<vType, vCount>::add(const array<vType, vCount> &piece, const uint32_t count) {
+        const size_t key = pieceKey(piece);
+
+        // first appearance of the piece
+        if (counts_[key] == 0)
+            order_.push_back(static_cast<uint32_t>(key));
+
+        counts_[key] += count;
+        total_ += count;
+    }
+
+    /**
+     * @brief Returns the number of copies of a piece.
+     *
+     * @param piece The piece to be found.
+     * @return The number of copies, 0 if the piece wasn't added.
+     */
+    template<typename vType, size_t vCount>
+    uint32_t PieceTable<vType, vCount>::count(const array<vType, vCount> &piece) const {
+        return counts_[pieceKey(piece)];
+    }
+
+    /**
+     * @brief Returns the number of distinct pieces.
+     */
+    template<typename vType, size_t vCount>
+    size_t PieceTable<vType, vCount>::distinct() const {
+        return order_.size();
+    }
+
+    /**
+     * @brief Returns the number of all pieces, copies included.
+     */
+    template<typename vType, size_t vCount>
+    size_t PieceTable<vType, vCount>::total() const {
+        return total_;
+    }
+
+    /**
+     * @brief Sorts the pieces that appeared first at or after an index of the order by their ranks.
+     *
+     * @param first The index of the order, earlier pieces keep their places.
+     * @param ranks The rank of every piece by its key, the smaller the earlier.
+     */
+    template<typename vType, size_t vCount>
+    void PieceTable<vType, vCount>::sortOrder(const size_t first, const vector<uint64_t> &ranks) {
+        std::sort(order_.begin() + static_cast<ptrdiff_t>(first), order_.end(), [&](const uint32_t a, const uint32_t b) {
+            return ranks[a] < ranks[b];
+        });
+    }
+
+    /**
+     * @brief Converts the table to a list with one element for every distinct piece.
+     *
+     * @return A list of shared pointers to the pieces, in the order of the first appearance.
+     */
+    template<typename vType, size_t vCount>
+    VertexList<vType, vCount> PieceTable<vType, vCount>::toList() const {
+        VertexList<vType, vCount> lines;
+
+        for (const uint32_t key: order_)
+            lines.emplace_back(make_shared<array<vType, vCount> >(pieceFromKey<vType, vCount>(key)));
+
+        return lines;
+    }
+
+    /**
+     * @brief Writes the table to a binary summary file.
+     *
+     * The summary has the number of numbers in a piece, the number of distinct pieces and then
+     * the key and the count of every distinct piece in the order of the first appearance.
+     * Its size depends only on the number of distinct pieces (8 MB at most), not on the size of the input.
+     * If the file can't be written, it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the summary file.
+     */
+    template<typename vType, size_t vCount>
+    void PieceTable<vType, vCount>::writeSummary(const string &fileName) const {
+        ofstream out(fileName, ios::binary | ios::trunc);
+        if (!out.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        const auto pieceSize = static_cast<uint32_t>(vCount);
+        const auto distinctCount = static_cast<uint64_t>(order_.size());
+        out.write(SUMMARY_MAGIC, sizeof(SUMMARY_MAGIC));
+        out.write(reinterpret_cast<const char *>(&pieceSize), sizeof(pieceSize));
+        out.write(reinterpret_cast<const char *>(&distinctCount), sizeof(distinctCount));
+
+        for (const uint32_t key: order_) {
+            const uint32_t entry[2] = {key, counts_[key]};
+            out.write(reinterpret_cast<const char *>(entry), sizeof(entry));
+        }
+
+        if (!out.flush())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[SUMMARY_INVALID], fileName);
+    }
+
+    /**
+     * @brief Adds all pieces of a binary summary file to the table.
+     *
+     * Counts of the same piece are added, so merging summaries of shards in any grouping gives
+     * the same table as reading all shards into one table in that order.
+     * If the file can't be read or isn't a summary of pieces of this size,
+     * it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the summary file.
+     */
+    template<typename vType, size_t vCount>
+    void PieceTable<vType, vCount>::mergeSummary(const string &fileName) {
+        ifstream in(fileName, ios::binary);
+        if (!in.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        char magic[sizeof(SUMMARY_MAGIC)];
+        uint32_t pieceSize;
+        uint64_t distinctCount;
+        if (!in.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), SUMMARY_MAGIC) ||
+            !in.read(reinterpret_cast<char *>(&pieceSize), sizeof(pieceSize)) || pieceSize != vCount ||
+            !in.read(reinterpret_cast<char *>(&distinctCount), sizeof(distinctCount)) || distinctCount > CAPACITY)
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[SUMMARY_INVALID], fileName);
+
+        // Entries are checked before they are added, so a damaged summary doesn't change the table
+        vector<uint32_t> entries(distinctCount * 2);
+        if (!in.read(reinterpret_cast<char *>(entries.data()),
+                     static_cast<streamsize>(entries.size() * sizeof(uint32_t))))
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[SUMMARY_INVALID], fileName);
+        for (size_t i = 0; i < entries.size(); i += 2)
+            if (entries[i] >= CAPACITY || entries[i + 1] == 0)
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[SUMMARY_INVALID], fileName);
+
+        for (size_t i = 0; i < entries.size(); i += 2) {
+            if (counts_[entries[i]] == 0)
+                order_.push_back(entries[i]);
+            counts_[entries[i]] += entries[i + 1];
+            total_ += entries[i + 1];
+        }
+    }
+
+    /**
+     * @brief Template function to read a file directly into a table of piece counts.
+     *
+     * This function reads a file line by line and adds every valid line to the table, so no lines are kept
+     * and the used memory doesn't depend on the size of the file.
+     * Invalid lines are reported the same way as by readFileToList, binary files are decoded as by it.
+     *
+     * @tparam vType The type of the numeric values in the pieces.
+     * @tparam vCount The number of the numeric values in a piece.
+     * @tparam stringSize The size of each line in the file.
+     * @param fileName The name of the file to be read.
+     * @param counts The table that receives the pieces.
+     */
+    template<typename vType, size_t vCount, size_t stringSize>
+    void readFileToTable(const string &fileName, PieceTable<vType, vCount> &counts) {
+        ifstream in(fileName);
+
+        // if file is not opened then throw exception
+        if (!in.is_open())
+            throw exceptionInFunction(
+                __FUNCTION__,
+                ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        // binary files are decoded, not parsed
+        char magic[sizeof(BINARY_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (isBinaryPieces({magic, static_cast<size_t>(in.gcount())})) {
+            in.close();
+            readBinaryPieces(fileName, vCount, [&](const size_t key, const uint32_t count) {
+                counts.add(pieceFromKey<vType, vCount>(key), count);
+            });
+            return;
+        }
+        in.clear();
+        in.seekg(0);
+
+        // one buffer for all lines
+        string line;
+
+        while (!in.eof()) {
+            getline(in, line);
+
+            // if line is invalid then throw exception and continue
+            try {
+                tryFunction(__FUNCTION__, stringIsValid<vType, stringSize, stringSize / vCount>, line, 0, 99);
+                counts.add(stringToArray<vType, vCount, stringSize / vCount>(line));
+            } catch (const BracedException &ex) {
+                cerr << ex.what() << endl;
+            }
+        }
+
+        in.close();
+    }
+
+    /**
+     * @brief Template function to read many files directly into a table of piece counts.
+     *
+     * Files are read asynchronously by readFiles and folded into the table as soon as each read completes.
+     * Every piece keeps the rank of its first appearance in the list (the index of the file and of the piece
+     * in it), and the new pieces of the table are sorted by it at the end, so the order of the first appearance,
+     * and the result, don't depend on the order of completion. The ranks take one number per possible piece,
+     * so the memory doesn't depend on the size of the input.
+     *
+     * @tparam vType The type of the numeric values in the pieces.
+     * @tparam vCount The number of the numeric values in a piece.
+     * @tparam stringSize The size of each line in the files.
+     * @param fileNames The names of the files to be read.
+     * @param counts The table that receives the pieces.
+     */
+    template<typename vType, size_t vCount, size_t stringSize>
+    void readFilesToTable(const vector<string> &fileNames, PieceTable<vType, vCount> &counts) {
+        const size_t firstNew = counts.distinct();
+        vector<uint64_t> ranks(PieceTable<vType, vCount>::CAPACITY, UINT64_MAX);
+
+        readFiles(fileNames, [&](const size_t file, const string_view content) {
+            uint64_t rank = static_cast<uint64_t>(file) << 32;
+            auto add = [&](const size_t key, const uint32_t count) {
+                ranks[key] = std::min(ranks[key], rank++);
+                counts.add(pieceFromKey<vType, vCount>(key), count);
+            };
+
+            // a damaged binary file is reported, the other files are still read
+            if (isBinaryPieces(content)) {
+                try {
+                    bufferBinaryPieces(content, vCount, fileNames[file], add);
+                } catch (const BracedException &ex) {
+                    cerr << ex.what() << endl;
+                }
+                return;
+            }
+
+            forEachLine(content, [&](const string &line) {
+                // if line is invalid then throw exception and continue
+                try {
+                    tryFunction(__FUNCTION__, stringIsValid<vType, stringSize, stringSize / vCount>, line, 0, 99);
+                    add(pieceKey(stringToArray<vType, vCount, stringSize / vCount>(line)), 1);
+                } catch (const BracedException &ex) {
+                    cerr << ex.what() << endl;
+                }
+            });
+        });
+
+        counts.sortOrder(firstNew, ranks);
+    }
+
+    /**
+     * @brief Template function to add the pieces appended to a followed file to a table of piece counts.
+     *
+     * Only the new complete lines are parsed, invalid lines are reported the same way as by readFileToList.
+     *
+     * @tparam vType The type of the numeric values in the pieces.
+     * @tparam vCount The number of the numeric values in a piece.
+     * @tparam stringSize The size of each line in the file.
+     * @param follower The followed file.
+     * @param counts The table that receives the pieces.
+     * @return The number of added pieces.
+     */
+    template<typename vType, size_t vCount, size_t stringSize>
+    size_t followFileToTable(FileFollower &follower, PieceTable<vType, vCount> &counts) {
+        const size_t totalBefore = counts.total();
+
+        follower.poll([&](const string_view content) {
+            forEachLine(content, [&](const string &line) {
+                // if line is invalid then throw exception and continue
+                try {
+                    tryFunction(__FUNCTION__, stringIsValid<vType, stringSize, stringSize / vCount>, line, 0, 99);
+                    counts.add(stringToArray<vType, vCount, stringSize / vCount>(line));
+                } catch (const BracedException &ex) {
+                    cerr << ex.what() << endl;
+                }
+            });
+        });
+        return counts.total() - totalBefore;
+    }
+
+    /**
+     * @brief Template function to collapse identical pieces of a list into one element with a count.
+     *
+     * @tparam vType The type of the numeric values in the vectors.
+     * @tparam vCount The size of the vectors.
+     * @param lines The list of pieces read from a file.
+     * @param counts The table that receives the number of copies of every piece.
+     * @return A list with the first copy of every piece, in the original order.
+     */
+    template<typename vType, size_t vCount>
+    VertexList<vType, vCount> collapseDuplicates(const VertexList<vType, vCount> &lines,
+                                                 PieceTable<vType, vCount> &counts) {
+        VertexList<vType, vCount> distinctLines;
+
+        for (const auto &row: lines) {
+            // only the first copy stays in the list
+            if (counts.count(*row) == 0)
+                distinctLines.push_back(row);
+            counts.add(*row);
+        }
+        return distinctLines;
+    }
+}
+#endif // PIECE_TABLE_INL
@@ -0,0 +1,99 @@
+/**
+ * @file QueryIndex.hpp
+ * @brief This file contains the declaration of the QueryIndex class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef QUERY_INDEX_HPP
+#define QUERY_INDEX_HPP
+
+#include <array>
+#include <optional>
+#include <sstream>
+#include <algorithm>
+#include "../Graph/Graph.hpp"
+
+namespace graph {
+    /**
+     * @brief Constraints of one query, a missing value means no constraint.
+     */
+    struct Query {
+        optional<unsigned> start; ///< The first number of the combination (`start <junction>`).
+        optional<unsigned> end; ///< The last number of the combination (`end <junction>`).
+        optional<size_t> piece; ///< Key of a piece the combination must contain (`contains <piece>`).
+    };
+
+    /**
+     * @brief Index that answers constrained queries about the longest combination of a graph.
+     *
+     * Every DFS tree of the graph is walked once, when the index is built. For every start junction,
+     * end junction, pair of them and piece the longest combination of the trees is summarized by its length,
+     * its start vertex and its record in the tree. A query then repeats DFS from one start vertex only
+     * and takes the path from the summarized record, so it takes milliseconds.
+     *
+     * @tparam vType The type of vertex data.
+     * @tparam vCount The number of numbers in a vertex.
+     */
+    template<typename vType, size_t vCount>
+    class QueryIndex {
+    public:
+        /**
+         * @brief Number of junctions (two-digit numbers).
+         */
+        static constexpr size_t JUNCTIONS = 100;
+
+        explicit QueryIndex(Graph<vType, vCount> &graph, size_t threadCount = 0);
+
+        static Query parseQuery(const string &line);
+
+        string answer(const Query &query);
+
+        bool reachable(unsigned start, unsigned end) const;
+
+    private:
+        using GraphType = Graph<vType, vCount>;
+        using SearchState = typename GraphType::SearchState;
+
+        static constexpr uint32_t NONE = GraphType::NONE;
+
+        /**
+         * @brief The longest combination for one constraint.
+         *
+         * Of equally long combinations the one with the earliest start and record wins,
+         * the same one a sequential walk would keep.
+         */
+        struct Best {
+            uint32_t length = 0; ///< Number of pieces.
+            uint32_t position = NONE; ///< Position of the start vertex in the start order.
+            uint32_t record = NONE; ///< Record of the last (or the contained) piece in the DFS tree.
+
+            bool isBetterThan(const Best &other) const;
+        };
+
+        /**
+         * @brief Summaries of all DFS trees.
+         */
+        struct Summaries {
+            array<Best, JUNCTIONS> byStart; ///< Indexed by the start junction.
+            array<Best, JUNCTIONS> byEnd; ///< Indexed by the end junction.
+            vector<Best> byStartEnd; ///< Indexed by start junction * JUNCTIONS + end junction.
+            vector<Best> byPiece; ///< Indexed by slot.
+
+            void merge(const Summaries &other);
+        };
+
+        GraphType &graph_;
+        Summaries summaries_;
+        unordered_map<size_t, uint32_t> pieceSlots_;
+        SearchState state_;
+
+        void summarize(const SearchState &state, uint32_t position, vector<uint32_t> &depths,
+                       Summaries &summaries) const;
+
+        void pathToRecord(uint32_t record, vector<uint32_t> &path) const;
+    };
+}
+
+#endif // QUERY_INDEX_HPP
+#include "QueryIndex.inl"
@@ -0,0 +1,256 @@
+/**
+ * @file QueryIndex.inl
+ * @brief This file contains the implementation of the QueryIndex class.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef QUERY_INDEX_INL
+#define QUERY_INDEX_INL
+
+namespace graph {
+    /**
+     * @brief Compares two summarized combinations.
+     *
+     * @param other The other combination.
+     * @return True if this combination is longer, or as long and found earlier.
+     */
+    template<typename vType, size_t vCount>
+    bool QueryIndex<vType, vCount>::Best::isBetterThan(const Best &other) const {
+        if (length != other.length)
+            return length > other.length;
+        if (position != other.position)
+            return position < other.position;
+        return record < other.record;
+    }
+
+    /**
+     * @brief Merges summaries made by another thread.
+     *
+     * @param other The other summaries.
+     */
+    template<typename vType, size_t vCount>
+    void QueryIndex<vType, vCount>::Summaries::merge(const Summaries &other) {
+        auto mergeRange = [](auto &target, const auto &source) {
+            for (size_t i = 0; i < target.size(); ++i)
+                if (source[i].isBetterThan(target[i]))
+                    target[i] = source[i];
+        };
+        mergeRange(byStart, other.byStart);
+        mergeRange(byEnd, other.byEnd);
+        mergeRange(byStartEnd, other.byStartEnd);
+        mergeRange(byPiece, other.byPiece);
+    }
+
+    /**
+     * @brief Builds the index, walking DFS trees of all start vertices of the graph.
+     *
+     * Start vertices are shared between threads, every thread summarizes its trees
+     * and the summaries are merged at the end.
+     *
+     * @param graph The graph.
+     * @param threadCount Number of threads, 0 means the number of hardware threads.
+     */
+    template<typename vType, size_t vCount>
+    QueryIndex<vType, vCount>::QueryIndex(GraphType &graph, size_t threadCount)
+        : graph_(graph) {
+        summaries_.byStartEnd.resize(JUNCTIONS * JUNCTIONS);
+        summaries_.byPiece.resize(graph_.slotLimits_.size());
+
+        for (uint32_t v = 0; v < graph_.vertexCount(); ++v)
+            pieceSlots_.emplace(GraphType::keyGenerator(graph_.vertexAt(v)), graph_.slots_[v]);
+
+        mutex summariesMutex;
+        atomic<size_t> nextPosition = 0;
+
+        auto worker = [&] {
+            SearchState state;
+            graph_.initState(state);
+            Summaries local = summaries_;
+            vector<uint32_t> depths;
+
+            for (size_t position = nextPosition++; position < graph_.order_.size(); position = nextPosition++) {
+                GraphType::newEpoch(state);
+                uint32_t startRecord;
+                graph_.dfsFrom(state, graph_.order_[position], startRecord, {});
+                summarize(state, static_cast<uint32_t>(position), depths, local);
+            }
+
+            lock_guard lock(summariesMutex);
+            summaries_.merge(local);
+        };
+
+        if (threadCount == 0)
+            threadCount = std::max(1u, thread::hardware_concurrency());
+        threadCount = std::min(threadCount, std::max<size_t>(1, graph_.order_.size()));
+
+        if (threadCount == 1)
+            worker();
+        else {
+            vector<jthread> workers;
+            for (size_t i = 0; i < threadCount; ++i)
+                workers.emplace_back(worker);
+        }
+
+        graph_.initState(state_);
+    }
+
+    /**
+     * @brief Adds all paths of one DFS tree to the summaries.
+     *
+     * A path from the root to any record is a combination that ends with the piece of the record,
+     * and a path through a record followed by its best continuation is a combination that contains it.
+     *
+     * @param state The state with records of the tree.
+     * @param position Position of the root in the start order.
+     * @param depths Buffer for depths of records.
+     * @param summaries Summaries to update.
+     */
+    template<typename vType, size_t vCount>
+    void QueryIndex<vType, vCount>::summarize(const SearchState &state, const uint32_t position,
+                                              vector<uint32_t> &depths, Summaries &summaries) const {
+        const size_t recordCount = state.recordVertices.size();
+        if (recordCount == 0)
+            return;
+
+        const unsigned startJunction = static_cast<unsigned>(graph_.vertexAt(state.recordVertices[0])->first());
+        const Best root{state.recordLengths[0], position, 0};
+        if (root.isBetterThan(summaries.byStart[startJunction]))
+            summaries.byStart[startJunction] = root;
+
+        // Parents are always recorded before children
+        depths.resize(recordCount);
+        for (uint32_t record = 0; record < recordCount; ++record) {
+            const uint32_t parent = state.recordParents[record];
+            depths[record] = parent == NONE ? 1 : depths[parent] + 1;
+
+            const uint32_t vertex = state.recordVertices[record];
+            const auto endJunction = static_cast<unsigned>(graph_.vertexAt(vertex)->last());
+
+            const Best ending{depths[record], position, record};
+            if (ending.isBetterThan(summaries.byEnd[endJunction]))
+                summaries.byEnd[endJunction] = ending;
+            Best &startEnd = summaries.byStartEnd[startJunction * JUNCTIONS + endJunction];
+            if (ending.isBetterThan(startEnd))
+                startEnd = ending;
+
+            const Best containing{depths[record] - 1 + state.recordLengths[record], position, record};
+            Best &piece = summaries.byPiece[graph_.slots_[vertex]];
+            if (containing.isBetterThan(piece))
+                piece = containing;
+        }
+    }
+
+    /**
+     * @brief Parses one line of a query file.
+     *
+     * A query is a list of constraints: `start <junction>`, `end <junction>` and `contains <piece>`,
+     * f.e. `start 34 end 12` or `contains 561234`. A piece can't be combined with other constraints.
+     * If the line is invalid, it throws a BracedException with a specific error message.
+     *
+     * @param line The line.
+     * @return The query.
+     */
+    template<typename vType, size_t vCount>
+    Query QueryIndex<vType, vCount>::parseQuery(const string &line) {
+        Query query;
+        istringstream in(line);
+        string name;
+        string value;
+
+        while (in >> name) {
+            if (!(in >> value) || !all_of(value.begin(), value.end(), ::isdigit))
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_QUERY], line);
+
+            if (name == "start" && value.size() == 2)
+                query.start = static_cast<unsigned>(stoul(value));
+            else if (name == "end" && value.size() == 2)
+                query.end = static_cast<unsigned>(stoul(value));
+            else if (name == "contains" && value.size() == vCount * 2)
+                query.piece = stoull(value);
+            else
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_QUERY], line);
+        }
+
+        if ((!query.start && !query.end && !query.piece) || (query.piece && (query.start || query.end)))
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[BAD_QUERY], line);
+        return query;
+    }
+
+    /**
+     * @brief Returns true if some combination starts at one junction and ends at another.
+     *
+     * @param start The start junction.
+     * @param end The end junction.
+     */
+    template<typename vType, size_t vCount>
+    bool QueryIndex<vType, vCount>::reachable(const unsigned start, const unsigned end) const {
+        return summaries_.byStartEnd[start * JUNCTIONS + end].length > 0;
+    }
+
+    /**
+     * @brief Restores the path from the root of the last DFS tree to a record.
+     *
+     * @param record The record.
+     * @param path The vector that receives positions of the vertices.
+     */
+    template<typename vType, size_t vCount>
+    void QueryIndex<vType, vCount>::pathToRecord(uint32_t record, vector<uint32_t> &path) const {
+        path.clear();
+        for (; record != NONE; record = state_.recordParents[record])
+            path.push_back(state_.recordVertices[record]);
+        std::reverse(path.begin(), path.end());
+    }
+
+    /**
+     * @brief Answers a query.
+     *
+     * The summary gives the start vertex and the record of the answer, DFS from that vertex
+     * makes the same tree again, and the combination is taken from it.
+     *
+     * @param query The query.
+     * @return The longest combination that satisfies the query, or an empty string if there is none.
+     */
+    template<typename vType, size_t vCount>
+    string QueryIndex<vType, vCount>::answer(const Query &query) {
+        Best best;
+        bool continuePath = false;
+
+        if (query.piece) {
+            const auto slot = pieceSlots_.find(*query.piece);
+            if (slot == pieceSlots_.end())
+                return {};
+            best = summaries_.byPiece[slot->second];
+            continuePath = true;
+        } else if (query.start && query.end) {
+            // Different junctions without a chain of arcs between them are rejected without the index
+            if (*query.start != *query.end && !graph_.closure().reaches(*query.start, *query.end))
+                return {};
+            best = summaries_.byStartEnd[*query.start * JUNCTIONS + *query.end];
+        } else if (query.start) {
+            best = summaries_.byStart[*query.start];
+            continuePath = true;
+        } else
+            best = summaries_.byEnd[*query.end];
+
+        if (best.length == 0)
+            return {};
+
+        // The same DFS tree again
+        GraphType::newEpoch(state_);
+        uint32_t startRecord;
+        graph_.dfsFrom(state_, graph_.order_[best.position], startRecord, {});
+
+        vector<uint32_t> path;
+        pathToRecord(best.record, path);
+
+        // The best continuation of the record, without the record itself
+        if (continuePath)
+            for (uint32_t record = state_.recordNext[best.record]; record != NONE;
+                 record = state_.recordNext[record])
+                path.push_back(state_.recordVertices[record]);
+
+        return graph_.combinationToString(path);
+    }
+}
+#endif // QUERY_INDEX_INL
@@ -0,0 +1,23 @@
+# Runs the program on one input without and with OPTIONS and checks that both combinations are valid
+# and equally long, and that both ways convert the same number of pieces.
+#
+# Variables:
+#   PROGRAM - the executable.
+#   INPUT - the input file.
+#   OPTIONS - the options of the second run, separated by semicolons.
+#   WORK_DIR - the directory for the converted files.
+
+include(${CMAKE_CURRENT_LIST_DIR}/RunProgram.cmake)
+
+run_search(expected ${INPUT})
+run_search(actual ${INPUT} ${OPTIONS})
+if (NOT expected STREQUAL actual)
+    message(FATAL_ERROR "Without options: ${expected}, with ${OPTIONS}: ${actual}")
+endif ()
+
+run_convert(expectedPieces ${WORK_DIR}/compare_expected.bin ${INPUT})
+run_convert(actualPieces ${WORK_DIR}/compare_actual.bin ${INPUT} ${OPTIONS})
+if (NOT expectedPieces STREQUAL actualPieces)
+    message(FATAL_ERROR "Without options: ${expectedPieces}, with ${OPTIONS}: ${actualPieces}")
+endif ()
+message(STATUS "${actual}, ${actualPieces}")
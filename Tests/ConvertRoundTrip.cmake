@@ -0,0 +1,25 @@
+# Converts the input to the binary format with OPTIONS and back, and checks that no piece is lost:
+# the number of converted pieces and the length of the combination are the same as for the input.
+#
+# Variables:
+#   PROGRAM - the executable.
+#   INPUT - the input file.
+#   OPTIONS - the options of the conversion, separated by semicolons.
+#   WORK_DIR - the directory for the converted files.
+
+include(${CMAKE_CURRENT_LIST_DIR}/RunProgram.cmake)
+
+run_convert(expectedPieces ${WORK_DIR}/expected.bin ${INPUT})
+run_convert(actualPieces ${WORK_DIR}/converted.bin ${INPUT} ${OPTIONS})
+run_convert(againPieces ${WORK_DIR}/again.bin ${WORK_DIR}/converted.bin)
+if (NOT expectedPieces STREQUAL actualPieces OR NOT expectedPieces STREQUAL againPieces)
+    message(FATAL_ERROR "Without options: ${expectedPieces}, with ${OPTIONS}: ${actualPieces}, "
+            "converted again: ${againPieces}")
+endif ()
+
+run_search(expected ${INPUT})
+run_search(actual ${WORK_DIR}/converted.bin)
+if (NOT expected STREQUAL actual)
+    message(FATAL_ERROR "Input: ${expected}, converted with ${OPTIONS}: ${actual}")
+endif ()
+message(STATUS "${actualPieces}, ${actual}")
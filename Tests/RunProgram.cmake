@@ -0,0 +1,36 @@
+# Helpers of the tests, they run the program and take values from its output.
+#
+# Variables:
+#   PROGRAM - the executable.
+
+# Runs the program with the arguments and stores its standard output, fails if the program fails.
+function(run_program result)
+    execute_process(COMMAND ${PROGRAM} ${ARGN}
+            OUTPUT_VARIABLE output
+            ERROR_QUIET
+            RESULT_VARIABLE code)
+    if (NOT code EQUAL 0)
+        message(FATAL_ERROR "`${PROGRAM} ${ARGN}` failed with ${code}:\n${output}")
+    endif ()
+    set(${result} "${output}" PARENT_SCOPE)
+endfunction()
+
+# Runs the program with the arguments and stores the length of its combination, fails if it isn't valid.
+function(run_search result)
+    run_program(output ${ARGN})
+    if (NOT output MATCHES "Puzzle combination is valid")
+        message(FATAL_ERROR "`${PROGRAM} ${ARGN}` gave an invalid combination:\n${output}")
+    endif ()
+    string(REGEX MATCH "\\* Length: [0-9]+" length "${output}")
+    set(${result} "${length}" PARENT_SCOPE)
+endfunction()
+
+# Runs the program with the arguments and `--convert <file>` and stores the number of converted pieces.
+function(run_convert result file)
+    run_program(output ${ARGN} --convert ${file})
+    string(REGEX MATCH "Converted [0-9]+ pieces" pieces "${output}")
+    if (NOT pieces)
+        message(FATAL_ERROR "`${PROGRAM} ${ARGN} --convert ${file}` didn't convert:\n${output}")
+    endif ()
+    set(${result} "${pieces}" PARENT_SCOPE)
+endfunction()
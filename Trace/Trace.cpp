@@ -0,0 +1,201 @@
+/**
+ * @file Trace.cpp
+ * @brief This file contains the implementation of the timeline tracing of the application.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#include "Trace.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../ErrorCodeStrings/ErrorCodes.hpp"
+#include "../BracedException/BracedException.hpp"
+#include "../Export/BufferedWriter.hpp"
+
+namespace trace {
+    ERRORS_
+    BR_EXCEPT_
+
+    namespace {
+        /**
+         * @brief One finished event.
+         */
+        struct TraceEvent {
+            const char *name; ///< Name of the event.
+            uint64_t begin; ///< Begin time in nanoseconds since the start of tracing.
+            uint64_t end; ///< End time in nanoseconds since the start of tracing.
+            uint64_t argument; ///< Argument of the event.
+        };
+
+        /**
+         * @brief Ring buffer of the events of one thread.
+         *
+         * Only the owner thread writes, it publishes every event by moving the head with release order,
+         * so recording never waits for other threads. When the buffer is full, the oldest events are overwritten.
+         */
+        struct ThreadTrace {
+            explicit ThreadTrace(const size_t capacity, const uint64_t id)
+                : events(capacity),
+                  threadId(id) {
+            }
+
+            vector<TraceEvent> events; ///< The ring.
+            atomic<uint64_t> head = 0; ///< Number of events recorded so far.
+            uint64_t threadId; ///< Number of the thread in the trace.
+        };
+
+        /**
+         * @brief Buffers of all threads, they live until the end of the program, so a trace can be written
+         * after the threads have finished.
+         */
+        mutex registryMutex;
+        vector<unique_ptr<ThreadTrace> > registry;
+        size_t threadCapacity = EVENTS_PER_THREAD;
+        chrono::steady_clock::time_point traceStart;
+
+        /**
+         * @brief Buffer of the current thread, registered by its first event.
+         */
+        thread_local ThreadTrace *threadTrace = nullptr;
+
+        ThreadTrace &currentThreadTrace() {
+            if (threadTrace == nullptr) {
+                lock_guard lock(registryMutex);
+                registry.push_back(make_unique<ThreadTrace>(threadCapacity, registry.size() + 1));
+                threadTrace = registry.back().get();
+            }
+            return *threadTrace;
+        }
+
+        /**
+         * @brief Writes a time in microseconds with three decimals, the unit of the trace event format.
+         */
+        void writeMicroseconds(graph::BufferedWriter &writer, const uint64_t nanoseconds) {
+            const auto fraction = static_cast<unsigned>(nanoseconds % 1000);
+            writer << nanoseconds / 1000 << '.' << static_cast<char>('0' + fraction / 100);
+            writer.twoDigits(fraction % 100);
+        }
+    }
+
+    /**
+     * @brief Starts recording of events, times are counted from this moment.
+     *
+     * @param eventsPerThread Number of events kept for every thread.
+     */
+    void startTracing(const size_t eventsPerThread) {
+        {
+            lock_guard lock(registryMutex);
+            threadCapacity = eventsPerThread == 0 ? 1 : eventsPerThread;
+            traceStart = chrono::steady_clock::now();
+        }
+        tracingEnabled.store(true, memory_order_release);
+    }
+
+    /**
+     * @brief Returns the time since the start of tracing.
+     *
+     * @return Nanoseconds, at least 1, because 0 marks a scope that isn't traced.
+     */
+    uint64_t traceClock() {
+        const auto elapsed = chrono::steady_clock::now() - traceStart;
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) + 1;
+    }
+
+    /**
+     * @brief Records a finished event in the buffer of the current thread.
+     *
+     * @param name The name of the event, it must be a string literal.
+     * @param begin The begin time from traceClock().
+     * @param end The end time from traceClock().
+     * @param argument The argument of the event, or NO_ARGUMENT.
+     */
+    void recordEvent(const char *name, const uint64_t begin, const uint64_t end, const uint64_t argument) {
+        ThreadTrace &buffer = currentThreadTrace();
+        const uint64_t head = buffer.head.load(memory_order_relaxed);
+
+        buffer.events[head % buffer.events.size()] = {name, begin, end, argument};
+        buffer.head.store(head + 1, memory_order_release);
+    }
+
+    /**
+     * @brief Writes all recorded events to a file in the Chrome trace event format.
+     *
+     * Every event is a complete event ("ph":"X") with its begin time and duration, so an event
+     * overwritten in a full ring never leaves a begin without an end. The file can be opened
+     * in chrome://tracing or Perfetto. It should be called when the traced threads have finished.
+     * If the file can't be opened, it throws a BracedException with a specific error message.
+     *
+     * @param fileName The name of the file.
+     */
+    void writeTrace(const string &fileName) {
+        ofstream out(fileName, ios::binary);
+        if (!out.is_open())
+            throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], fileName);
+
+        graph::BufferedWriter writer(out);
+        bool first = true;
+        auto separate = [&] {
+            if (!first)
+                writer << ",\n";
+            first = false;
+        };
+
+        writer << "{\"traceEvents\":[\n";
+
+        lock_guard lock(registryMutex);
+        for (const auto &buffer: registry) {
+            separate();
+            writer << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->threadId
+                    << R"(,"args":{"name":"thread )" << buffer->threadId << "\"}}";
+
+            const uint64_t head = buffer->head.load(memory_order_acquire);
+            const uint64_t capacity = buffer->events.size();
+            for (uint64_t i = head > capacity ? head - capacity : 0; i < head; ++i) {
+                const TraceEvent &event = buffer->events[i % capacity];
+
+                separate();
+                writer << R"({"name":")" << string_view(event.name) << R"(","ph":"X","pid":1,"tid":)"
+                        << buffer->threadId << ",\"ts\":";
+                writeMicroseconds(writer, event.begin);
+                writer << ",\"dur\":";
+                writeMicroseconds(writer, event.end - event.begin);
+                if (event.argument != NO_ARGUMENT)
+                    writer << R"(,"args":{"id":)" << event.argument << '}';
+                writer << '}';
+            }
+        }
+
+        writer << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    /**
+     * @brief Starts tracing if a file is given.
+     *
+     * @param fileName The name of the trace file, an empty name disables tracing.
+     */
+    TraceFile::TraceFile(string fileName)
+        : fileName_(std::move(fileName)) {
+        if (!fileName_.empty())
+            startTracing();
+    }
+
+    /**
+     * @brief Writes the trace, a failure is reported and doesn't stop the program.
+     */
+    TraceFile::~TraceFile() {
+        if (fileName_.empty())
+            return;
+
+        try {
+            writeTrace(fileName_);
+        } catch (const BracedException &ex) {
+            cerr << ex.what() << endl;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Trace.hpp
+ * @brief This file contains the declaration of the timeline tracing of the application.
+ * @author Maksym
+ * @date 18.10.2026
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Namespace for timeline tracing.
+ */
+namespace trace {
+    using namespace std;
+
+    /**
+     * @brief Default number of events kept for every thread, older events are overwritten.
+     */
+    constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+    /**
+     * @brief Marker for an event without an argument.
+     */
+    constexpr uint64_t NO_ARGUMENT = UINT64_MAX;
+
+    /**
+     * @brief Tracing is enabled, checked by every scope before it reads the clock.
+     */
+    inline atomic<bool> tracingEnabled{false};
+
+    void startTracing(size_t eventsPerThread = EVENTS_PER_THREAD);
+
+    uint64_t traceClock();
+
+    void recordEvent(const char *name, uint64_t begin, uint64_t end, uint64_t argument);
+
+    void writeTrace(const string &fileName);
+
+    /**
+     * @brief Records the time between its construction and destruction as one event of the current thread.
+     *
+     * Without tracing it only checks a flag, so it may stay in the hot loops.
+     */
+    class TraceScope {
+    public:
+        /**
+         * @brief Begins an event.
+         *
+         * @param name The name of the event, it must be a string literal.
+         * @param argument A number shown with the event, f.e. the index of a work unit.
+         */
+        explicit TraceScope(const char *name, const uint64_t argument = NO_ARGUMENT)
+            : name_(name),
+              argument_(argument),
+              begin_(tracingEnabled.load(memory_order_relaxed) ? traceClock() : 0) {
+        }
+
+        /**
+         * @brief Ends the event, if it wasn't ended before.
+         */
+        ~TraceScope() {
+            end();
+        }
+
+        /**
+         * @brief Ends the event before the end of the scope.
+         */
+        void end() {
+            if (begin_ != 0)
+                recordEvent(name_, begin_, traceClock(), argument_);
+            begin_ = 0;
+        }
+
+        TraceScope(const TraceScope &) = delete;
+
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    private:
+        const char *name_;
+        uint64_t argument_;
+        uint64_t begin_;
+    };
+
+    /**
+     * @brief Starts tracing when it is constructed and writes the trace when it is destroyed,
+     * so the trace is written however the traced block ends.
+     */
+    class TraceFile {
+    public:
+        explicit TraceFile(string fileName);
+
+        ~TraceFile();
+
+        TraceFile(const TraceFile &) = delete;
+
+        TraceFile &operator=(const TraceFile &) = delete;
+
+    private:
+        string fileName_;
+    };
+}
+
+/**
+ * @brief Macro to simplify the use of the trace namespace.
+ */
+#define TRACE_ using namespace trace;
+
+#endif // TRACE_HPP
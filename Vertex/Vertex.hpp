@@ -51,9 +51,20 @@ namespace graph {
             : Vertex(vNumbers, {}) {
         }
 
+        /**
+         * @brief Constructor for a vertex that stands for several identical pieces.
+         * @param vNumbers Vertex data.
+         * @param count Number of identical pieces.
+         */
+        Vertex(const VertexNumbers<vType, vCount> &vNumbers, const uint32_t count)
+            : vNumbers_(vNumbers),
+              count_(count) {
+        }
+
     private:
         VertexNumbers<vType, vCount> vNumbers_;
         list<Edge<vType, vCount> > edges_;
+        uint32_t count_ = 1;
 
     public:
         void addEdge(const Edge<vType, vCount> &edge);
@@ -64,6 +75,8 @@ namespace graph {
 
         const VertexNumbers<vType, vCount> &vNumbers() const;
 
+        uint32_t count() const { return count_; }
+
         const list<Edge<vType, vCount> > &edges() const;
 
         template<typename T, size_t C>
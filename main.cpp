@@ -4,55 +4,277 @@
 #include "FileReader/ReaderFunctions.hpp"
 #include "Graph/Graph.hpp"
 #include "Vertex/Vertex.hpp"
+#include "PieceTable/PieceTable.hpp"
+#include "Options/Options.hpp"
+#include "Export/GraphExport.hpp"
+#include "Query/QueryIndex.hpp"
+#include "Trace/Trace.hpp"
+#include "Allocation/Allocation.hpp"
+#include <fstream>
+#include <chrono>
+#include <thread>
 BR_EXCEPT_
 READER_
 GRAPH_
+OPTIONS_
+ERRORS_
+TRACE_
+ALLOCATION_
 #define VERTEX_COUNT 3
 #define STRING_SIZE 6
 
-int main(int argc, char *argv[]) {
-    string inputFile = "source.txt";
-    bool showGraph = argc >= 3 && string(argv[2]) == "s";
-    if (argc >= 2)
-        inputFile = argv[1];
+/**
+ * @brief Time between two checks of a followed file.
+ */
+constexpr chrono::milliseconds FOLLOW_INTERVAL{500};
+
+/**
+ * @brief Follows the input file, solving the puzzle again whenever pieces are appended to it.
+ *
+ * New bytes are folded into a table of piece counts, so the file is never parsed again,
+ * and the graph is created from the table, whose size doesn't depend on the size of the file.
+ * A combination is printed only when it is longer than the previous one.
+ * The function returns only if an exception is thrown.
+ *
+ * @param options The options of the run.
+ */
+static void followFile(const Options &options) {
+    PieceTable<int16_t, VERTEX_COUNT> counts;
+    FileFollower follower(options.inputFile);
+    size_t longestLength = 0;
+
+    cout << "1. Following file: {" << options.inputFile << "}." << endl;
 
+    while (true) {
+        // Nothing new, or no connected pieces yet
+        const size_t added = followFileToTable<int16_t, VERTEX_COUNT, STRING_SIZE>(follower, counts);
+        const auto data = listToMap(added != 0 ? counts.toList() : VertexList<int16_t, VERTEX_COUNT>{});
 
+        if (!data.empty()) {
+            Graph<int16_t, 3> graph = options.collapse
+                                          ? Graph<int16_t, 3>::createGraph(data, counts, options.implicitEdges)
+                                          : Graph<int16_t, 3>::createGraph(data, options.implicitEdges);
+            string dfs = graph.dfs(options.threads, {}, *solverByName(options.solver));
+            if (options.splice && graph.spliceCycles() != 0)
+                dfs = graph.combinationToString(graph.bestPath());
+
+            if (dfs.length() > longestLength) {
+                longestLength = dfs.length();
+                graph.puzzleCombinationIsValid(dfs);
+
+                cout << "2. Longer puzzle after " << counts.total() << " pieces:\n* Combination: \n" << dfs << endl;
+                cout << "* Length: " << dfs.length() << endl;
+            }
+        }
+
+        this_thread::sleep_for(FOLLOW_INTERVAL);
+    }
+}
+
+int main(int argc, char *argv[]) {
     try {
-        auto list = tryFunction(__FUNCTION__, readFileToList<int16_t, VERTEX_COUNT, STRING_SIZE>, inputFile);
+        const Options options = tryFunction(__FUNCTION__, parseOptions, argc, argv);
+        const TraceFile traceFile(options.traceFile);
+        const AllocationReport allocationReport(options.allocations);
+        if (options.checkAllocations)
+            startCounting();
+
+        if (options.follow) {
+            followFile(options);
+            return 0;
+        }
+
+        PieceTable<int16_t, VERTEX_COUNT> counts;
+        VertexList<int16_t, VERTEX_COUNT> list;
+
+        TraceScope traceRead("read");
+        AllocationStage allocationRead("read");
+        if (!options.mergeList.empty()) {
+            const auto fileNames = tryFunction(__FUNCTION__, readFileNames, options.mergeList);
+
+            for (const auto &fileName: fileNames)
+                counts.mergeSummary(fileName);
+            list = counts.toList();
+
+            cout << "1. Merged " << fileNames.size() << " summaries: {" << options.mergeList << "}." << endl;
+        } else if (!options.fileList.empty()) {
+            const auto fileNames = tryFunction(__FUNCTION__, readFileNames, options.fileList);
+
+            if (options.stream) {
+                tryFunction(__FUNCTION__, readFilesToTable<int16_t, VERTEX_COUNT, STRING_SIZE>, fileNames, counts);
+                list = counts.toList();
+            } else
+                list = tryFunction(__FUNCTION__, readFilesToList<int16_t, VERTEX_COUNT, STRING_SIZE>, fileNames);
+
+            cout << "1. Read data from " << fileNames.size() << " files: {" << options.fileList << "}." << endl;
+        } else {
+            if (options.stream) {
+                tryFunction(__FUNCTION__, readFileToTable<int16_t, VERTEX_COUNT, STRING_SIZE>, options.inputFile,
+                            counts);
+                list = counts.toList();
+            } else
+                list = tryFunction(__FUNCTION__, readFileToList<int16_t, VERTEX_COUNT, STRING_SIZE>,
+                                   options.inputFile);
+
+            cout << "1. Read data from file: {" << options.inputFile << "}." << endl;
+        }
+        traceRead.end();
+        allocationRead.end();
+
+        if (options.stream)
+            cout << "1.1. Streamed " << counts.total() << " pieces to " << counts.distinct() << " distinct." << endl;
+        else if (options.collapse) {
+            TraceScope traceCollapse("collapse");
+            AllocationStage allocationCollapse("collapse");
+            list = collapseDuplicates(list, counts);
+            traceCollapse.end();
+            allocationCollapse.end();
 
-        cout << "1. Read data from file: {" << inputFile << "}." << endl;
+            cout << "1.1. Collapsed " << counts.total() << " pieces to " << counts.distinct() << " distinct." << endl;
+        }
+
+        if (!options.convertFile.empty()) {
+            // Pieces of the table (collapsed or streamed) are written once with their multiplicities
+            const bool counted = options.collapse || options.stream;
+            vector<pair<uint32_t, uint32_t> > pieces;
+            size_t pieceTotal = 0;
+            for (const auto &row: list) {
+                pieces.emplace_back(static_cast<uint32_t>(pieceKey(*row)), counted ? counts.count(*row) : 1);
+                pieceTotal += pieces.back().second;
+            }
+            writeBinaryPieces(options.convertFile, pieces, counted);
+
+            cout << "2. Converted " << pieceTotal << " pieces to {" << options.convertFile << "}." << endl;
+            return 0;
+        }
+
+        if (!options.summaryFile.empty()) {
+            counts.writeSummary(options.summaryFile);
 
+            cout << "2. Wrote summary to {" << options.summaryFile << "}." << endl;
+            return 0;
+        }
+
+        TraceScope traceMap("listToMap");
+        AllocationStage allocationMap("listToMap");
         auto data = listToMap(list);
+        traceMap.end();
+        allocationMap.end();
 
         cout << "2. Converted string list to map." << endl;
 
-        Graph<int16_t, 3> graph = Graph<int16_t, 3>::createGraph(data);
+        AllocationStage allocationGraph("createGraph");
+        Graph<int16_t, 3> graph = options.collapse
+                                      ? Graph<int16_t, 3>::createGraph(data, counts, options.implicitEdges)
+                                      : Graph<int16_t, 3>::createGraph(data, options.implicitEdges);
+        allocationGraph.end();
 
-        cout << "3. Created graph." << endl;
+        cout << "3. Created graph (" << graph.componentCount() << " components)." << endl;
 
-        if (showGraph) {
+        if (options.showGraph) {
             cout << "Graph: \n";
             cout << "_____________\n\n";
-            cout << graph::to_string(graph);
+            exportGraph(graph, cout, ExportFormat::TEXT);
             cout << "_____________\n\n";
         }
 
+        if (!options.queryFile.empty()) {
+            ifstream queries(options.queryFile);
+            if (!queries.is_open())
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], options.queryFile);
+
+            TraceScope traceIndex("queryIndex");
+            AllocationStage allocationIndex("queryIndex");
+            QueryIndex<int16_t, 3> index(graph, options.threads);
+            traceIndex.end();
+            allocationIndex.end();
+
+            cout << "4. Built query index." << endl;
+
+            string line;
+            while (getline(queries, line)) {
+                if (line.empty() || line.starts_with('#'))
+                    continue;
+
+                TraceScope traceQuery("query");
+                const auto started = chrono::steady_clock::now();
+                const string combination = index.answer(QueryIndex<int16_t, 3>::parseQuery(line));
+                const auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - started);
 
-        cout << "4. Starting DFS." << endl;
+                if (!combination.empty())
+                    graph.puzzleCombinationIsValid(combination);
 
-        auto dfs = graph.dfs();
+                cout << "* Query: {" << line << "} (" << elapsed.count() << " ms)\n"
+                        << "  Combination: " << (combination.empty() ? "none" : combination) << "\n"
+                        << "  Length: " << combination.length() << endl;
+            }
+            return 0;
+        }
+
+        cout << "4. Starting DFS (solver " << options.solver << ")." << endl;
+
+        string dfs;
+        TraceScope traceSearch("dfs");
+        AllocationStage allocationSearch("dfs");
+        if (options.progress) {
+            // Solutions are printed as soon as they are found, the last one is the longest
+            for (Solution &solution: graph.solutions()) {
+                cout << "4.1. Found combination of length " << solution.combination.length()
+                        << " (start " << solution.startsSearched << " of " << solution.startCount << ")." << endl;
+                dfs = std::move(solution.combination);
+            }
+        } else
+            dfs = graph.dfs(options.threads, {
+                                options.checkpointFile, options.resume,
+                                chrono::seconds(options.checkpointInterval)
+                            }, *solverByName(options.solver));
+        traceSearch.end();
+        allocationSearch.end();
 
         cout << "5. DFS finished." << endl;
 
+        if (options.checkAllocations) {
+            checkHotPath();
+            cout << "5.1. Inner loop of the search didn't allocate." << endl;
+        }
+
+        if (options.splice) {
+            TraceScope traceSplice("splice");
+            AllocationStage allocationSplice("splice");
+            const size_t added = graph.spliceCycles();
+            if (added != 0)
+                dfs = graph.combinationToString(graph.bestPath());
+            cout << "5.2. Spliced " << added << " pieces in loops into the combination." << endl;
+        }
+
         cout << "6. Longest puzzle:\n* Combination: \n" << dfs << endl;
 
         cout << "* Length: " << dfs.length() << endl;
 
+        TraceScope traceValidate("validate");
+        AllocationStage allocationValidate("validate");
         graph.puzzleCombinationIsValid(dfs);
+        traceValidate.end();
+        allocationValidate.end();
 
         cout << "7. Puzzle combination is valid." << endl;
+
+        if (!options.exportFormat.empty()) {
+            TraceScope traceExport("export");
+            AllocationStage allocationExport("export");
+            ofstream exportStream(options.exportFile, ios::binary);
+            if (!exportStream.is_open())
+                throw exceptionInFunction(__FUNCTION__, ERROR_MESSAGES[FILE_NOT_OPENED], options.exportFile);
+
+            exportGraph(graph, exportStream,
+                        options.exportFormat == "dot" ? ExportFormat::DOT : ExportFormat::JSON,
+                        graph.bestPath());
+
+            cout << "8. Exported graph to {" << options.exportFile << "}." << endl;
+        }
     } catch (const BracedException &ex) {
         std::cerr << ex.what() << std::endl;
+        return 1;
     }
 
     return 0;
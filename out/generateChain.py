@@ -0,0 +1,51 @@
+import random
+import sys
+
+# Generates a single chain of pieces for the DFS depth benchmark.
+# Every piece is [first, middle, last] and the last number of each piece is the first number of the next one,
+# so the whole file is one Eulerian trail over the 100 junctions.
+#
+# Usage: python generateChain.py [piece_count] [output_file]
+
+JUNCTIONS = 100
+
+
+def chain_pieces():
+    # Arcs of the complete graph on junctions, one arc for every middle number,
+    # self loops are skipped, because they can only end a combination
+    arcs = {j: [(k, m) for k in range(JUNCTIONS) if k != j for m in range(100)] for j in range(JUNCTIONS)}
+
+    # Shuffled with a fixed seed, so the chain spreads over all junctions and every run is the same
+    random.seed(41)
+    for junction_arcs in arcs.values():
+        random.shuffle(junction_arcs)
+
+    # Iterative Hierholzer's algorithm
+    stack = [(0, None)]
+    trail = []
+    while stack:
+        junction, piece = stack[-1]
+        if arcs[junction]:
+            nxt, middle = arcs[junction].pop()
+            stack.append((nxt, (junction, middle, nxt)))
+        else:
+            stack.pop()
+            if piece is not None:
+                trail.append(piece)
+    trail.reverse()
+    return trail
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) >= 2 else 1000000
+    output = sys.argv[2] if len(sys.argv) >= 3 else "chain.txt"
+
+    trail = chain_pieces()
+    with open(output, "w") as file:
+        # Chains longer than the trail repeat it, repeated pieces are visited only once
+        lines = (trail[i % len(trail)] for i in range(count))
+        file.write("\n".join(f"{a:02d}{m:02d}{b:02d}" for a, m, b in lines))
+
+
+if __name__ == "__main__":
+    main()
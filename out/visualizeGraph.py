@@ -1,6 +1,13 @@
+import json
+import sys
+
 import networkx as nx
 import matplotlib.pyplot as plt
 
+# Usage: python visualizeGraph.py [graph.json]
+# The JSON file is written by "test_task <input> --export json",
+# without it the graph of testData.txt below is drawn.
+
 # Define nodes and edges
 nodes = [
     345120,
@@ -28,6 +35,22 @@ edges = [
 max_path = [901234, 341056, 561234, 345678, 789012, 120345]
 
 
+def load_export(file_name):
+    # Vertices are numbered in the export, identical pieces may be different vertices
+    with open(file_name) as file:
+        graph = json.load(file)
+    labels = {node["id"]: node["piece"] for node in graph["nodes"]}
+    return (list(labels),
+            [(edge[0], edge[1]) for edge in graph["edges"]],
+            graph["path"],
+            labels)
+
+
+labels = None
+if len(sys.argv) >= 2:
+    nodes, edges, max_path, labels = load_export(sys.argv[1])
+
+
 def draw_longest_path(nodes, edges, max_path):
     # Create the graph
     G = nx.DiGraph()
@@ -43,7 +66,7 @@ def draw_longest_path(nodes, edges, max_path):
 
     # Draw all edges
     nx.draw(
-        G, pos, with_labels=True, node_size=500,
+        G, pos, with_labels=True, labels=labels, node_size=500,
         node_color="skyblue", font_size=10, font_weight="bold",
         edge_color="gray"
     )